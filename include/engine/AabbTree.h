@@ -0,0 +1,111 @@
+#ifndef __AABB_TREE__
+#define __AABB_TREE__
+
+#include <utility>
+#include <vector>
+#include "BroadPhase.h"
+
+// Dynamic bounding volume tree broad phase: proxies are the leaves of a balanced binary tree, where each node bounds it's children
+// Leaves hold "fat" bounds, enlarged by a margin, so that proxies which barely moved don't have to be reinserted
+// Queries & insertions take logarithmic time, whatever the sizes of the proxies, so it suits worlds of very uneven objects
+class AabbTree : public BroadPhase
+{
+public:
+  // Margin added around leaves unless configured otherwise
+  static const float defaultFatMargin;
+
+  AabbTree(float fatMargin = defaultFatMargin) : fatMargin(fatMargin) {}
+
+  int CreateProxy(const Bounds &bounds) override;
+  void MoveProxy(int proxy, const Bounds &bounds) override;
+  void DestroyProxy(int proxy) override;
+  void FindPairs(std::vector<std::pair<int, int>> &pairs) override;
+  void Query(const Bounds &bounds, std::vector<int> &proxies) override;
+
+  // Calls back with each proxy whose fat bounds overlap the bounds
+  // The callback must not change the tree
+  template <class Callback>
+  void Query(const Bounds &bounds, Callback callback)
+  {
+    stack.clear();
+
+    if (root != nullNode)
+      stack.push_back(root);
+
+    while (stack.empty() == false)
+    {
+      int index = stack.back();
+      stack.pop_back();
+
+      const Node &node = nodes[index];
+
+      if (node.bounds.Overlaps(bounds) == false)
+        continue;
+
+      if (node.IsLeaf())
+        callback(index);
+      else
+      {
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+      }
+    }
+  }
+
+  // Height of the root (a single leaf has height 0)
+  int GetHeight() const { return root == nullNode ? 0 : nodes[root].height; }
+
+  // How many times proxies left their fat bounds and had to be reinserted
+  int GetReinsertCount() const { return reinsertCount; }
+
+private:
+  static const int nullNode;
+
+  struct Node
+  {
+    // Union of it's children, or fat bounds for leaves
+    Bounds bounds;
+
+    // Exact bounds of a leaf's proxy
+    Bounds proxyBounds;
+
+    // Parent node (or next free node, once freed)
+    int parent;
+
+    int child1, child2;
+
+    // Leaves have height 0, free nodes -1
+    int height;
+
+    bool IsLeaf() const { return child1 == nullNode; }
+  };
+
+  int AllocateNode();
+  void FreeNode(int index);
+
+  void InsertLeaf(int leaf);
+  void RemoveLeaf(int leaf);
+
+  // Rotates the subtree if it's children heights differ by more than one, returning the index of it's new root
+  int Balance(int index);
+
+  // Recomputes the bounds & heights from the node up to the root, balancing along the way
+  void Refit(int index);
+
+  float fatMargin;
+
+  std::vector<Node> nodes;
+
+  int root{nullNode};
+
+  // Head of the list of free nodes
+  int freeList{nullNode};
+
+  int reinsertCount{0};
+
+  // Traversal stacks, reused from one search to the next
+  std::vector<int> stack;
+  std::vector<std::pair<int, int>> nodeStack;
+};
+
+#endif
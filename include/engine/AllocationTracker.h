@@ -0,0 +1,64 @@
+#ifndef __ALLOCATION_TRACKER__
+#define __ALLOCATION_TRACKER__
+
+#include <cstddef>
+
+// Phases of a frame, in the order the engine executes them
+enum class FramePhase
+{
+  Input,
+  Update,
+  Delete,
+  Collisions,
+  Events,
+  Render,
+  Other
+};
+
+// Counts heap allocations per frame and per frame phase
+// Only counts when the engine is compiled with ALLOCATION_TRACKING defined, otherwise every counter stays at zero
+class AllocationTracker
+{
+public:
+  // Allocation count & allocated bytes
+  struct Counter
+  {
+    size_t allocations{0};
+    size_t bytes{0};
+  };
+
+  // Whether the global allocation functions are being replaced
+  static bool Enabled();
+
+  // Sets which phase subsequent allocations are attributed to
+  static void SetPhase(FramePhase phase);
+
+  // Closes the current frame: stores it's counters and checks them against the budget
+  static void EndFrame();
+
+  // Configures how many allocations a steady state frame may perform, and how many frames to wait before enforcing it
+  static void SetBudget(size_t maxAllocationsPerFrame, int warmupFrames = 30);
+
+  // When set, exceeding the budget throws instead of only warning
+  static void SetStrict(bool strict);
+
+  // Totals of the last closed frame
+  static Counter GetLastFrame();
+
+  // Counters of a given phase in the last closed frame
+  static Counter GetLastFrame(FramePhase phase);
+
+  // How many frames exceeded the budget so far
+  static int GetBudgetViolations();
+
+  // Forgets all recorded frames (use when a new state is pushed, as loading is expected to allocate)
+  static void ResetWarmup();
+
+  // Prints a summary of the recorded frames
+  static void Report();
+
+  // Called by the replaced allocation functions
+  static void Record(size_t bytes);
+};
+
+#endif
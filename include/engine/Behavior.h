@@ -0,0 +1,119 @@
+#ifndef __BEHAVIOR__
+#define __BEHAVIOR__
+
+#include <coroutine>
+#include <type_traits>
+#include <utility>
+#include "TimingWheel.h"
+
+class Component;
+
+// A coroutine run on behalf of a component: declare a component method returning Behavior, and suspend it with co_await
+// It runs as soon as it's called, and is only resumed once what it awaits is done, so it costs nothing while waiting
+// Destroying it (usually along with the component that stores it) cancels whatever it was waiting for
+class Behavior
+{
+public:
+  struct promise_type
+  {
+    // The component comes first, as the implicit object parameter of it's method
+    template <class Owner, class... Args>
+    promise_type(Owner &owner, Args &...) : wheel(&owner.gameState.timingWheel)
+    {
+      static_assert(std::is_base_of_v<Component, std::remove_reference_t<Owner>>, "A behavior must be a component method");
+    }
+
+    Behavior get_return_object() { return Behavior(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    // Stay around once finished, so the behavior can tell it's done
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    void return_void() {}
+
+    // Let exceptions reach whoever resumed it
+    void unhandled_exception() { throw; }
+
+    // The state's timing wheel, in which waits are scheduled
+    TimingWheel *wheel;
+  };
+
+  Behavior() {}
+  ~Behavior() { Reset(); }
+
+  Behavior(Behavior &&other) : coroutine(std::exchange(other.coroutine, nullptr)) {}
+
+  Behavior &operator=(Behavior &&other)
+  {
+    if (this != &other)
+    {
+      Reset();
+      coroutine = std::exchange(other.coroutine, nullptr);
+    }
+
+    return *this;
+  }
+
+  Behavior(const Behavior &) = delete;
+  Behavior &operator=(const Behavior &) = delete;
+
+  // Whether it ran to the end (or was never started)
+  bool IsDone() const { return !coroutine || coroutine.done(); }
+
+  // Stops it where it's suspended
+  void Reset()
+  {
+    if (coroutine)
+      coroutine.destroy();
+
+    coroutine = nullptr;
+  }
+
+private:
+  explicit Behavior(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+  std::coroutine_handle<promise_type> coroutine;
+};
+
+// Awaitable which resumes a behavior after the given amount of seconds
+class Wait
+{
+public:
+  explicit Wait(float seconds) : seconds(seconds) {}
+
+  // Cancels the resume if the behavior is destroyed while waiting
+  ~Wait()
+  {
+    if (wheel != nullptr)
+      wheel->Cancel(handle);
+  }
+
+  Wait(const Wait &) = delete;
+  Wait &operator=(const Wait &) = delete;
+
+  // Always suspends, so that even a zero wait gives way until the next tick
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<Behavior::promise_type> coroutine)
+  {
+    wheel = coroutine.promise().wheel;
+    // Transient, as behaviors can't be saved in snapshots
+    handle = wheel->Schedule(
+        seconds, [coroutine]()
+        { coroutine.resume(); },
+        0.0f, true);
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  float seconds;
+
+  // Wheel the resume is scheduled in
+  TimingWheel *wheel{nullptr};
+
+  TimerHandle handle;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef __BINARY_STREAM__
+#define __BINARY_STREAM__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Vector2.h"
+#include "Rectangle.h"
+#include "Color.h"
+#include "Helper.h"
+
+// Appends values, as raw bytes, to a buffer
+// The buffer isn't cleared, so it's memory can be reused from one write to the next
+class BinaryWriter
+{
+public:
+  BinaryWriter(std::vector<uint8_t> &buffer) : buffer(buffer) {}
+
+  template <class T>
+  void Write(const T &value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written as raw bytes");
+
+    size_t position = buffer.size();
+    buffer.resize(position + sizeof(T));
+    memcpy(buffer.data() + position, &value, sizeof(T));
+  }
+
+  void Write(const std::string &value)
+  {
+    Write<uint32_t>(value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+  }
+
+  void Write(const Vector2 &value)
+  {
+    Write(value.x);
+    Write(value.y);
+  }
+
+  void Write(const Rectangle &value)
+  {
+    Write(value.x);
+    Write(value.y);
+    Write(value.width);
+    Write(value.height);
+  }
+
+  void Write(const Color &value)
+  {
+    Write(value.red);
+    Write(value.green);
+    Write(value.blue);
+    Write(value.alpha);
+  }
+
+  // Writes many values at once
+  template <class T>
+  void WriteArray(const T *values, size_t count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written as raw bytes");
+
+    size_t position = buffer.size();
+    buffer.resize(position + count * sizeof(T));
+    memcpy(buffer.data() + position, values, count * sizeof(T));
+  }
+
+  // Overwrites a value written before, at the given position (use it to fill in sizes once known)
+  template <class T>
+  void Patch(size_t position, const T &value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written as raw bytes");
+
+    memcpy(buffer.data() + position, &value, sizeof(T));
+  }
+
+  // How many bytes the buffer has
+  size_t Size() const { return buffer.size(); }
+
+private:
+  std::vector<uint8_t> &buffer;
+};
+
+// Reads values back from the bytes written by a BinaryWriter
+class BinaryReader
+{
+public:
+  BinaryReader(const uint8_t *data, size_t size) : data(data), size(size) {}
+
+  BinaryReader(const std::vector<uint8_t> &buffer) : BinaryReader(buffer.data(), buffer.size()) {}
+
+  template <class T>
+  T Read()
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be read as raw bytes");
+
+    T value;
+    memcpy(&value, Take(sizeof(T)), sizeof(T));
+
+    return value;
+  }
+
+  // Reads many values at once
+  template <class T>
+  void ReadArray(T *values, size_t count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be read as raw bytes");
+
+    memcpy(values, Take(count * sizeof(T)), count * sizeof(T));
+  }
+
+  std::string ReadString()
+  {
+    uint32_t length = Read<uint32_t>();
+
+    return std::string((const char *)Take(length), length);
+  }
+
+  Vector2 ReadVector2()
+  {
+    float x = Read<float>();
+    return Vector2(x, Read<float>());
+  }
+
+  Rectangle ReadRectangle()
+  {
+    float x = Read<float>(), y = Read<float>(), width = Read<float>();
+    return Rectangle(x, y, width, Read<float>());
+  }
+
+  Color ReadColor()
+  {
+    int red = Read<int>(), green = Read<int>(), blue = Read<int>();
+    return Color(red, green, blue, Read<int>());
+  }
+
+  // Reads the next bytes as a separate reader, which can't read past them
+  BinaryReader ReadBlock(size_t bytes) { return BinaryReader(Take(bytes), bytes); }
+
+  // Skips the given amount of bytes
+  void Skip(size_t bytes) { Take(bytes); }
+
+  size_t GetPosition() const { return position; }
+
+  bool AtEnd() const { return position == size; }
+
+private:
+  // Gets the next bytes, advancing past them
+  const uint8_t *Take(size_t bytes)
+  {
+    CHECK(position + bytes <= size, "Tried to read past the end of binary data");
+
+    const uint8_t *start = data + position;
+    position += bytes;
+
+    return start;
+  }
+
+  const uint8_t *data;
+  size_t size;
+  size_t position{0};
+};
+
+#endif
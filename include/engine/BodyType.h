@@ -0,0 +1,15 @@
+#ifndef __BODY_TYPE__
+#define __BODY_TYPE__
+
+// How a collider moves, which tells what collision detection can skip
+enum class BodyType
+{
+  // Never moves: placed once, and never tested against other static colliders
+  Static,
+  // Moved by code every frame it needs to, so it never sleeps
+  Kinematic,
+  // Moves & rests: sleeps after staying still for a while, until something moving touches it
+  Dynamic
+};
+
+#endif
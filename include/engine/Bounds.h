@@ -0,0 +1,60 @@
+#ifndef __BOUNDS__
+#define __BOUNDS__
+
+#include <algorithm>
+#include <cmath>
+#include "Vector2.h"
+#include "Rectangle.h"
+
+// Axis aligned bounding box, given by it's corners
+class Bounds
+{
+public:
+  // Corner with the lowest coordinates
+  Vector2 min;
+
+  // Corner with the highest coordinates
+  Vector2 max;
+
+  Bounds() {}
+
+  Bounds(Vector2 min, Vector2 max) : min(min), max(max) {}
+
+  // Bounds of a rectangle (whose x & y are it's center) rotated around it's center
+  static Bounds Of(const Rectangle &box, float rotation = 0.0f)
+  {
+    float cosine = std::abs(std::cos(rotation)), sine = std::abs(std::sin(rotation));
+    Vector2 halfSize((box.width * cosine + box.height * sine) / 2, (box.width * sine + box.height * cosine) / 2);
+
+    return Bounds(box.Center() - halfSize, box.Center() + halfSize);
+  }
+
+  // Whether they share any point (touching counts)
+  bool Overlaps(const Bounds &other) const
+  {
+    return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y && other.min.y <= max.y;
+  }
+
+  // Whether the other one is entirely inside it
+  bool Contains(const Bounds &other) const
+  {
+    return min.x <= other.min.x && min.y <= other.min.y && other.max.x <= max.x && other.max.y <= max.y;
+  }
+
+  // Smallest bounds containing both
+  Bounds Union(const Bounds &other) const
+  {
+    return Bounds(Vector2(std::min(min.x, other.min.x), std::min(min.y, other.min.y)),
+                  Vector2(std::max(max.x, other.max.x), std::max(max.y, other.max.y)));
+  }
+
+  // Grows it by the margin on every side
+  Bounds Expanded(float margin) const { return Bounds(min - Vector2(margin, margin), max + Vector2(margin, margin)); }
+
+  Vector2 Size() const { return max - min; }
+
+  // Half of the perimeter (the cost bounding volume trees keep low)
+  float HalfPerimeter() const { return (max.x - min.x) + (max.y - min.y); }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef __BROAD_PHASE__
+#define __BROAD_PHASE__
+
+#include <utility>
+#include <vector>
+#include "Bounds.h"
+
+// Finds which colliders' bounds overlap, so that only those pairs go through the narrow phase
+// Each collider gets a proxy, whose bounds are updated every frame it's awake, so implementations can keep structures across frames
+class BroadPhase
+{
+public:
+  virtual ~BroadPhase() {}
+
+  // Adds bounds, returning the id of it's proxy (ids are small, and reused once destroyed)
+  virtual int CreateProxy(const Bounds &bounds) = 0;
+
+  // Updates the bounds of a proxy
+  virtual void MoveProxy(int proxy, const Bounds &bounds) = 0;
+
+  virtual void DestroyProxy(int proxy) = 0;
+
+  // Finds the pairs of proxies whose bounds overlap (lowest id first), each reported once
+  // The pairs buffer is cleared first
+  virtual void FindPairs(std::vector<std::pair<int, int>> &pairs) = 0;
+
+  // Appends the proxies whose bounds overlap the bounds, each once, as they were at the last search for pairs
+  virtual void Query(const Bounds &bounds, std::vector<int> &proxies) = 0;
+
+  // Times each broad phase against testing all pairs, with proxies of very uneven sizes drifting around, and prints the results
+  static void Benchmark(int proxyCount, int frames);
+};
+
+#endif
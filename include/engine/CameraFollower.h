@@ -20,6 +20,8 @@ public:
     gameObject.SetPosition(useRawPosition ? Camera::GetInstance().GetRawPosition() : Camera::GetInstance().GetPosition());
   }
 
+  void SaveConstruction(BinaryWriter &writer) override;
+
   bool useRawPosition;
 };
 
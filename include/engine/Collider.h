@@ -5,42 +5,70 @@
 #include "Component.h"
 #include "Vector2.h"
 #include "Rectangle.h"
+#include "CollisionLayer.h"
+#include "ColliderShape.h"
+#include "BodyType.h"
 
 class Sprite;
 class SpriteAnimator;
 
 class Collider : public Component
 {
+  friend GameState;
+
 public:
   // Explicitly initialize box
-  Collider(GameObject &associatedObject, Rectangle box);
+  Collider(GameObject &associatedObject, Rectangle box, ColliderShape shape = ColliderShape::Box);
 
   // Use sprite's box
-  Collider(GameObject &associatedObject, std::shared_ptr<Sprite> sprite, Vector2 scale = Vector2::One());
+  Collider(GameObject &associatedObject, std::shared_ptr<Sprite> sprite, Vector2 scale = Vector2::One(), ColliderShape shape = ColliderShape::Box);
 
   // Use sprite animator's frame size
-  Collider(GameObject &associatedObject, std::shared_ptr<SpriteAnimator> animator, Vector2 scale = Vector2::One());
+  Collider(GameObject &associatedObject, std::shared_ptr<SpriteAnimator> animator, Vector2 scale = Vector2::One(),
+           ColliderShape shape = ColliderShape::Box);
 
-  virtual ~Collider() {}
+  // Leaves the state's registry, if it's still in it (objects removed without being destroyed, as by snapshots, only get here)
+  virtual ~Collider();
 
   void Start() override;
   void Render() override;
+  void OnBeforeDestroy() override;
 
   // Get the box, with it's x & y coordinates corresponding to it's actual position in game
   Rectangle GetBox() const;
   // Set the box, assuming x & y coordinates correspond to an offset from the gameObject's position
   void SetBox(const Rectangle &box);
 
-  float GetMaxVertexDistance() const { return maxVertexDistance; }
+  // Shape fitted into the box
+  ColliderShape GetShape() const { return shape; }
+  void SetShape(ColliderShape shape);
+
+  // Radius of the smallest circle around the shape, from the box's center
+  float GetBoundingRadius() const { return boundingRadius; }
 
   RenderLayer GetRenderLayer() override { return RenderLayer::Debug; }
 
+  void SaveConstruction(BinaryWriter &writer) override;
+
+  // Layer it collides in (the state's collision matrix tells which layers it's tested against)
+  CollisionLayer layer{CollisionLayer::Default};
+
+  // Whether it's motion between frames is swept, so that it can't skip past thin colliders when fast (costlier to test)
+  bool continuous{false};
+
+  // How it moves (static colliders only have their box read when they get a proxy, so they must be moved by setting them up again)
+  BodyType bodyType{BodyType::Dynamic};
+
 private:
   // Collision detection area (x & y coordinates dictate the offset of the box from the object's position)
   Rectangle box;
 
-  // Maximum distance of a vertex from the rectangle's center
-  float maxVertexDistance;
+  ColliderShape shape;
+
+  float boundingRadius;
+
+  // Index in the state's collider registry (-1 while not in it)
+  int registryIndex{-1};
 };
 
 #include "Sprite.h"
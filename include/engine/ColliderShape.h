@@ -0,0 +1,15 @@
+#ifndef __COLLIDER_SHAPE__
+#define __COLLIDER_SHAPE__
+
+// Possible shapes of each collider, all fitted into it's box (the cheapest to test first)
+enum class ColliderShape
+{
+  // Largest circle inside the box
+  Circle,
+  // Rounded along the box's longest side: a segment through it's middle, widened by half of the shortest side
+  Capsule,
+  // The box itself
+  Box
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef __COLLISION_LAYER__
+#define __COLLISION_LAYER__
+
+// Possible collision layers of each collider (the state's collision matrix tells which of them are tested against each other)
+enum class CollisionLayer
+{
+  Default,
+  Player,
+  Enemies,
+  PlayerProjectiles,
+  EnemyProjectiles,
+  // How many layers there are (not a layer itself)
+  Count
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef __COLLISION_MATRIX__
+#define __COLLISION_MATRIX__
+
+#include <cstdint>
+#include "CollisionLayer.h"
+
+// Tells which pairs of collision layers interact: pairs of colliders whose layers don't are dropped right after the broad phase
+// It's symmetric, and every layer interacts with every other one until configured otherwise
+class CollisionMatrix
+{
+public:
+  CollisionMatrix();
+
+  void SetInteraction(CollisionLayer layer1, CollisionLayer layer2, bool interacts);
+
+  // Makes no layers interact, so that only the wanted pairs need to be set
+  void Clear();
+
+  bool Interacts(CollisionLayer layer1, CollisionLayer layer2) const { return masks[(int)layer1] & (1u << (int)layer2); }
+
+  // Bit i tells whether the layer interacts with layer i (a layer mask for spatial queries)
+  uint32_t GetMask(CollisionLayer layer) const { return masks[(int)layer]; }
+
+  // Name of a layer, for reports
+  static const char *GetName(CollisionLayer layer);
+
+private:
+  // Bit i of a layer's mask tells whether it interacts with layer i
+  uint32_t masks[(int)CollisionLayer::Count];
+};
+
+#endif
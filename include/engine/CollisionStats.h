@@ -0,0 +1,92 @@
+#ifndef __COLLISION_STATS__
+#define __COLLISION_STATS__
+
+#include <cstddef>
+#include "CollisionLayer.h"
+
+// Counts how much work collision detection does, to tell how many pairs the broad phase culls
+class CollisionStats
+{
+public:
+  // Counters of a frame, or sums of many
+  struct Counter
+  {
+    // Awake colliders
+    size_t colliders{0};
+
+    // Of which are static, and dynamic ones sleeping after staying still
+    size_t staticColliders{0};
+    size_t sleepingColliders{0};
+
+    // Pairs of colliders an all pairs test would go through
+    size_t allPairs{0};
+
+    // Pairs of colliders given by the broad phase
+    size_t candidatePairs{0};
+
+    // Candidate pairs dropped as their layers don't interact
+    size_t culledPairs{0};
+
+    // Candidate pairs skipped as both are static, or as neither moved (their contact carries over)
+    size_t staticPairs{0};
+    size_t restingPairs{0};
+
+    // Sleeping colliders woken by something moving touching them
+    size_t wokenColliders{0};
+
+    // Pairs of colliders whose bounding circles are apart
+    size_t circleRejections{0};
+
+    // Pairs of unrotated colliders whose boxes are apart
+    size_t boxRejections{0};
+
+    // Pairs with a continuous collider, swept to find when they touch
+    size_t sweptTests{0};
+
+    // Pairs of colliders with a round shape, tested by distance
+    size_t shapeTests{0};
+
+    // Pairs of colliders tested with SAT
+    size_t narrowTests{0};
+
+    // Pairs of objects found colliding
+    size_t hits{0};
+
+    // Of which started colliding, and pairs that stopped
+    size_t enteredContacts{0};
+    size_t exitedContacts{0};
+
+    // Candidate pairs of each pair of layers (lowest layer first), kept or culled
+    size_t keptLayerPairs[(int)CollisionLayer::Count][(int)CollisionLayer::Count]{};
+    size_t culledLayerPairs[(int)CollisionLayer::Count][(int)CollisionLayer::Count]{};
+
+    // Counts a candidate pair of colliders of these layers
+    void CountLayerPair(CollisionLayer layer1, CollisionLayer layer2, bool culled);
+
+    void Add(const Counter &other);
+  };
+
+  // Whether states print their report when destroyed
+  static void SetReporting(bool reporting);
+
+  // Closes the current frame, adding it to the totals
+  void EndFrame();
+
+  // Counters of the frame being detected
+  Counter &GetFrame() { return frame; }
+
+  // Counters of the last closed frame
+  const Counter &GetLastFrame() const { return lastFrame; }
+
+  // Prints the averages per frame (if reporting)
+  void Report() const;
+
+private:
+  static bool reporting;
+
+  Counter frame, lastFrame, total;
+
+  int frames{0};
+};
+
+#endif
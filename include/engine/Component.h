@@ -4,25 +4,31 @@
 #include "InputManager.h"
 #include "Vector2.h"
 #include "RenderLayer.h"
+#include "UpdateScheduler.h"
 #include <string>
 #include <memory>
 
+// Locks the weak pointer into a new shared pointer variable, asserting that it succeeded
 #define LOCK(weak, shared)   \
   auto shared = weak.lock(); \
-  Assert(shared != nullptr,  \
-         "Unexpectedly failed to lock shared pointer at " __FILE__ ":" + std::to_string(__LINE__) + " ");
+  ASSERT(shared != nullptr, "Unexpectedly failed to lock shared pointer " #weak);
 
-#define LOCK_MESSAGE(weak, shared, message) \
-  auto shared = weak.lock();                \
-  Assert(shared != nullptr, message);
+// Same as LOCK, with a custom message (any list of values to print)
+#define LOCK_MESSAGE(weak, shared, ...) \
+  auto shared = weak.lock();            \
+  ASSERT(shared != nullptr, __VA_ARGS__);
 
 class GameObject;
 class GameState;
+class Snapshot;
+class BinaryWriter;
+class BinaryReader;
 
 class Component
 {
   friend GameObject;
   friend GameState;
+  friend Snapshot;
 
 public:
   Component(GameObject &associatedObject);
@@ -35,6 +41,9 @@ public:
   // The order in which to render this component in it's layer (higher numbers are shown on top)
   virtual int GetRenderOrder() { return 0; }
 
+  // How low this component's update rate may drop when it's object is away from the camera view
+  virtual UpdateRate GetMinUpdateRate() { return UpdateRate::Full; }
+
   void StartAndRegisterLayer();
 
   // Returns this component's shared pointer
@@ -67,15 +76,38 @@ protected:
   // Called on the frame it is destroyed, right before being destroyed
   virtual void OnBeforeDestroy() {}
 
+  // === SNAPSHOTS (the type must be registered with REGISTER_COMPONENT to be rebuilt)
+
+  // Writes the arguments it's registered factory needs to construct it again
+  virtual void SaveConstruction([[maybe_unused]] BinaryWriter &writer) {}
+
+  // Writes the state that changes during play
+  virtual void SaveState([[maybe_unused]] BinaryWriter &writer) {}
+
+  // Reads back what SaveState wrote
+  virtual void LoadState([[maybe_unused]] BinaryReader &reader) {}
+
+  // Called once a snapshot is fully restored, to find other objects again and resume what can't be saved (like behaviors)
+  virtual void OnRestore() {}
+
   // Reference to input manager
   InputManager &inputManager;
 
 private:
-  // Allows for reacting to collision
-  virtual void OnCollision([[maybe_unused]] GameObject &other) {}
+  // Allows for reacting to collision: when a contact with another object begins, every later frame it goes on, and when it ends
+  // (contacts with destroyed objects end without notice)
+  virtual void OnCollisionEnter([[maybe_unused]] GameObject &other) {}
+  virtual void OnCollisionStay([[maybe_unused]] GameObject &other) {}
+  virtual void OnCollisionExit([[maybe_unused]] GameObject &other) {}
 
   // Whether StartAndRegisterLayer has been called already
   bool started{false};
+
+  // Time of the frames skipped by a lowered update rate, handed to the next update
+  float pendingDeltaTime{0.0f};
+
+  // Frames since the last update
+  int waitedFrames;
 };
 
 #include "GameObject.h"
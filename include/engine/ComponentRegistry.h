@@ -0,0 +1,55 @@
+#ifndef __COMPONENT_REGISTRY__
+#define __COMPONENT_REGISTRY__
+
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include "BinaryStream.h"
+
+class Component;
+class GameObject;
+
+// Constructs a component on the object, reading the arguments written by it's SaveConstruction
+typedef std::shared_ptr<Component> (*ComponentFactory)(GameObject &object, BinaryReader &reader);
+
+// Registers a component type, so that it can be rebuilt from a snapshot (use it once, in the component's source file)
+#define REGISTER_COMPONENT(type, factory) \
+  [[maybe_unused]] static const int type##RegistryId = ComponentRegistry::Register(typeid(type), #type, factory);
+
+// Keeps track of the component types which can be saved and rebuilt
+class ComponentRegistry
+{
+public:
+  // Registers a type, returning it's id
+  static int Register(const std::type_info &type, const std::string &name, ComponentFactory factory);
+
+  // Id of the component's type (-1 if it isn't registered)
+  static int GetId(const Component &component);
+
+  // Id of the type registered with this name (-1 if there's none)
+  static int GetId(const std::string &name);
+
+  // Constructs a component of the given registered type on the object
+  static std::shared_ptr<Component> Create(int id, GameObject &object, BinaryReader &reader);
+
+  // Name of a registered type
+  static const std::string &GetName(int id);
+
+private:
+  struct Entry
+  {
+    std::string name;
+    ComponentFactory factory;
+  };
+
+  // Registered types, indexed by id (function statics, as registration happens during static initialization)
+  static std::vector<Entry> &GetEntries();
+
+  // Id of each registered type
+  static std::unordered_map<std::type_index, int> &GetIds();
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef __DELEGATE__
+#define __DELEGATE__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Default amount of bytes a delegate can store inline
+#define DELEGATE_DEFAULT_CAPACITY 48
+
+template <typename Signature, size_t Capacity = DELEGATE_DEFAULT_CAPACITY>
+class Delegate;
+
+// Callable wrapper, like std::function, but which stores the callable inside a fixed size buffer and never allocates
+// Callables which don't fit in the capacity fail to compile
+template <typename Return, typename... Args, size_t Capacity>
+class Delegate<Return(Args...), Capacity>
+{
+  // Copies, moves or destroys the stored callable
+  enum class Operation
+  {
+    copy,
+    move,
+    destroy
+  };
+
+  typedef Return (*Invoker)(void *, Args &&...);
+  typedef void (*Manager)(Operation, void *, void *);
+
+public:
+  // Empty delegate
+  Delegate() {}
+  Delegate(std::nullptr_t) {}
+
+  // From any callable
+  template <typename Callable,
+            typename Stored = std::decay_t<Callable>,
+            typename = std::enable_if_t<!std::is_same_v<Stored, Delegate> &&
+                                        std::is_invocable_r_v<Return, Stored &, Args...>>>
+  Delegate(Callable &&callable)
+  {
+    static_assert(sizeof(Stored) <= Capacity,
+                  "Delegate capture is too big for it's capacity: capture less or raise the delegate's capacity");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t), "Delegate capture has unsupported alignment");
+    static_assert(std::is_copy_constructible_v<Stored>, "Delegate callables must be copyable");
+
+    new (storage) Stored(std::forward<Callable>(callable));
+
+    invoker = [](void *stored, Args &&...args) -> Return
+    { return (*static_cast<Stored *>(stored))(std::forward<Args>(args)...); };
+
+    manager = [](Operation operation, void *destination, void *source)
+    {
+      if (operation == Operation::copy)
+        new (destination) Stored(*static_cast<const Stored *>(source));
+      else if (operation == Operation::move)
+        new (destination) Stored(std::move(*static_cast<Stored *>(source)));
+      else
+        static_cast<Stored *>(destination)->~Stored();
+    };
+  }
+
+  Delegate(const Delegate &other) { CopyFrom(other); }
+
+  Delegate(Delegate &&other) noexcept { MoveFrom(other); }
+
+  ~Delegate() { Reset(); }
+
+  Delegate &operator=(const Delegate &other)
+  {
+    if (this != &other)
+    {
+      Reset();
+      CopyFrom(other);
+    }
+
+    return *this;
+  }
+
+  Delegate &operator=(Delegate &&other) noexcept
+  {
+    if (this != &other)
+    {
+      Reset();
+      MoveFrom(other);
+    }
+
+    return *this;
+  }
+
+  Delegate &operator=(std::nullptr_t)
+  {
+    Reset();
+    return *this;
+  }
+
+  // Calls the stored callable. Must not be empty
+  Return operator()(Args... args) const { return invoker(storage, std::forward<Args>(args)...); }
+
+  // Whether a callable is stored
+  explicit operator bool() const { return invoker != nullptr; }
+
+  bool operator==(std::nullptr_t) const { return invoker == nullptr; }
+  bool operator!=(std::nullptr_t) const { return invoker != nullptr; }
+
+  // Destroys the stored callable
+  void Reset()
+  {
+    if (manager)
+      manager(Operation::destroy, storage, nullptr);
+
+    invoker = nullptr;
+    manager = nullptr;
+  }
+
+private:
+  void CopyFrom(const Delegate &other)
+  {
+    if (other.manager)
+      other.manager(Operation::copy, storage, other.storage);
+
+    invoker = other.invoker;
+    manager = other.manager;
+  }
+
+  void MoveFrom(Delegate &other)
+  {
+    if (other.manager)
+      other.manager(Operation::move, storage, other.storage);
+
+    invoker = other.invoker;
+    manager = other.manager;
+
+    other.Reset();
+  }
+
+  // Where the callable lives (mutable, as calling a const delegate may mutate it's callable, like std::function)
+  alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+
+  // Calls the stored callable
+  Invoker invoker{nullptr};
+
+  // Manages the stored callable's lifetime
+  Manager manager{nullptr};
+};
+
+#endif
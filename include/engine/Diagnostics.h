@@ -0,0 +1,72 @@
+#ifndef __DIAGNOSTICS__
+#define __DIAGNOSTICS__
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+// Which diagnostics are compiled in:
+// 0: only CHECK, for errors the game can't go on from (failed loads, corrupted files...)
+// 1: also WARN
+// 2: also ASSERT, for invariants of the engine & game code (the default)
+#ifndef DIAGNOSTICS_LEVEL
+#define DIAGNOSTICS_LEVEL 2
+#endif
+
+// The message of each macro is given as a list of values to print one after the other
+// They are only evaluated when the check fails (or the warning is printed), so a passing check costs a single branch
+
+// Throws a runtime error if the condition is false, at every level
+#define CHECK(condition, ...)                             \
+  do                                                      \
+  {                                                       \
+    if (!(condition)) [[unlikely]]                        \
+      Diagnostics::Fail(__FILE__, __LINE__, __VA_ARGS__); \
+  } while (false)
+
+#if DIAGNOSTICS_LEVEL >= 2
+// Throws a runtime error if the condition is false
+#define ASSERT(condition, ...) CHECK(condition, __VA_ARGS__)
+#else
+// Stripped: the condition isn't evaluated, but still has to compile
+#define ASSERT(condition, ...)  \
+  do                            \
+  {                             \
+    (void)sizeof(!(condition)); \
+  } while (false)
+#endif
+
+#if DIAGNOSTICS_LEVEL >= 1
+// Prints a warning
+#define WARN(...) Diagnostics::Warn(__VA_ARGS__)
+#else
+#define WARN(...) \
+  do              \
+  {               \
+  } while (false)
+#endif
+
+namespace Diagnostics
+{
+  // Builds the message of a failed check & throws it
+  // Kept out of line & marked cold, so that it doesn't weigh on the code of the check
+  template <class... Parts>
+  [[noreturn, gnu::cold, gnu::noinline]] void Fail(const char *file, int line, const Parts &...parts)
+  {
+    std::ostringstream message;
+    (message << ... << parts);
+    message << " (at " << file << ":" << line << ")";
+
+    throw std::runtime_error(message.str());
+  }
+
+  template <class... Parts>
+  [[gnu::cold, gnu::noinline]] void Warn(const Parts &...parts)
+  {
+    std::cout << "WARNING: ";
+    (std::cout << ... << parts);
+    std::cout << std::endl;
+  }
+}
+
+#endif
@@ -1,30 +1,145 @@
 #ifndef __EVENT__
 #define __EVENT__
 
-#include <unordered_map>
-#include <functional>
-#include <string>
+#include <vector>
+#include "Delegate.h"
 
-class Event
+// Identifies a listener subscribed to an event
+typedef int ListenerHandle;
+
+// Counts event activity in a frame
+struct EventStats
 {
-  typedef std::function<void(void)> functionType;
+  // How many events were invoked
+  int invoked{0};
+
+  // How many of those were deferred to the event queue
+  int deferred{0};
+
+  // How many listener calls were made, immediately or from the queue
+  int listenersCalled{0};
+};
+
+class Event;
 
+// Holds deferred listener calls until they are dispatched in a single batch
+// Calls are kept by listener handle, so listeners removed before the dispatch aren't called
+// An event destroyed before the dispatch (along with it's object) hands it's queued calls over, so they still happen
+class EventQueue
+{
 public:
-  void AddListener(const std::string &id, functionType callback) { listeners[id] = callback; }
+  EventQueue();
+
+  // Queues a call to one of the event's listeners
+  void Push(Event &event, ListenerHandle listener) { queued.push_back(Call{&event, listener, nullptr}); }
+
+  // Calls every queued listener still subscribed, including the ones queued while dispatching
+  void Dispatch();
 
-  void RemoveListener(const std::string &id) { listeners.erase(id); }
+  // How many calls are waiting
+  int Count() const { return queued.size(); }
+
+private:
+  friend class Event;
 
-  void Invoke()
+  // A listener to call
+  struct Call
   {
-    for (auto const& entry : listeners)
-      entry.second();
-  }
+    // Null once the event is destroyed
+    Event *event;
+    ListenerHandle listener;
+
+    // The listener's callback, taken from the event when it was destroyed
+    Delegate<void(void)> callback;
+  };
+
+  // Takes the callbacks of the calls to an event's listeners, as it's being destroyed
+  void Detach(Event &event);
+
+  // Calls waiting to be dispatched
+  std::vector<Call> queued;
+
+  // Calls being dispatched (kept around to reuse it's memory)
+  std::vector<Call> dispatching;
+};
+
+class Event
+{
+  typedef Delegate<void(void)> functionType;
+
+public:
+  // Calls listeners as soon as it's invoked
+  Event() {}
+
+  // Defers listener calls to the given queue
+  Event(EventQueue &queue) : queue(&queue) {}
 
-  int Count() { return listeners.size(); }
+  // Hands it's calls still waiting in the queue over to it
+  ~Event();
+
+  // The queue refers to it by address
+  Event(const Event &) = delete;
+  Event &operator=(const Event &) = delete;
+
+  // Subscribes a listener, returning the handle with which to remove it
+  ListenerHandle AddListener(functionType callback);
+
+  void RemoveListener(ListenerHandle handle);
+
+  void Invoke();
+
+  int Count() const { return listeners.size() - removedWhileInvoking + pendingListeners.size(); }
+
+  // Whether listener calls are deferred to a queue
+  bool IsDeferred() const { return queue != nullptr; }
+
+  // Counters of the last closed frame
+  static const EventStats &GetLastFrameStats() { return lastFrameStats; }
+
+  // Closes the frame's counters
+  static void EndFrame();
 
 private:
-  // All listener callbacks subscribed to this event
-  std::unordered_map<std::string, functionType> listeners;
+  friend class EventQueue;
+
+  struct Listener
+  {
+    ListenerHandle handle;
+    functionType callback;
+  };
+
+  // Adds listeners subscribed while invoking & erases the ones removed while invoking
+  void SettleListeners();
+
+  // Calls a listener whose call was deferred, if it's still subscribed
+  void CallDeferred(ListenerHandle handle);
+
+  // The subscribed listener with this handle (null if there's none)
+  Listener *FindListener(ListenerHandle handle);
+
+  // All listener callbacks subscribed to this event, in subscription order
+  std::vector<Listener> listeners;
+
+  // Listeners subscribed while invoking (the main list can't grow while it's callbacks are running)
+  std::vector<Listener> pendingListeners;
+
+  // Queue to defer calls to, if any
+  EventQueue *queue{nullptr};
+
+  // Handle to give to the next listener
+  ListenerHandle nextHandle{0};
+
+  // How many invocations of this event are running (listeners may invoke it again)
+  int invokeDepth{0};
+
+  // How many listeners were removed while invoking (they are erased afterwards)
+  int removedWhileInvoking{0};
+
+  // Counters of the frame in progress
+  static EventStats frameStats;
+
+  // Counters of the last closed frame
+  static EventStats lastFrameStats;
 };
 
-#endif
\ No newline at end of file
+#endif
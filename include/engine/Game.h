@@ -5,6 +5,7 @@
 #include <memory>
 #include <stack>
 #include "Helper.h"
+#include "SpriteBatch.h"
 
 class GameState;
 
@@ -23,17 +24,29 @@ public:
   // Defines the resolution height
   static const int screenHeight;
 
+  // Defines how many heap allocations a steady state frame may perform (only checked when built with ALLOCATION_TRACKING)
+  static const int frameAllocationBudget;
+
+  // Seed of the random generator when running headless
+  static const int headlessSeed;
+
   // === FUNCTIONS
 
   // Gets the game instance if it exists or creates one if it doesn't
   static Game &GetInstance();
 
+  // Whether to run without a window or sound, at fixed time steps & with a fixed random seed (must be set before the instance is created)
+  static void SetHeadless(bool headless) { Game::headless = headless; }
+
   // Gets the current game state
   GameState &GetState() const;
 
   // Gets the renderer
   SDL_Renderer *GetRenderer() const { return renderer.get(); }
 
+  // Gets the batch sprites are drawn through
+  SpriteBatch &GetSpriteBatch() { return spriteBatch; }
+
   // Starts the game
   void Start();
 
@@ -65,6 +78,9 @@ private:
   // Game instance
   static std::unique_ptr<Game> gameInstance;
 
+  // Whether it runs headless
+  static bool headless;
+
   // Start time of current frame, in milliseconds
   int frameStart{(int)SDL_GetTicks()};
 
@@ -85,6 +101,9 @@ private:
 
   // Renderer for the window (with destructor function)
   Helper::auto_unique_ptr<SDL_Renderer> renderer;
+
+  // Gathers the sprites drawn each frame into as few draw calls as possible
+  SpriteBatch spriteBatch;
 };
 
 #include "GameState.h"
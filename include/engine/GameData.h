@@ -12,6 +12,9 @@ public:
   }
 
   bool playerWon{false};
+
+  // Whether to time loading the main scene from a file against building it from recipes, then quit
+  bool benchmarkScene{false};
 };
 
 #endif
\ No newline at end of file
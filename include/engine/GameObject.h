@@ -14,10 +14,12 @@
 #include "Timer.h"
 
 class GameState;
+class Snapshot;
 
 class GameObject
 {
   friend GameState;
+  friend Snapshot;
 
 public:
   // With dimensions
@@ -90,6 +92,14 @@ public:
 
   auto GetComponent(const Component *componentPointer) const -> std::shared_ptr<Component>;
 
+  // Position of the component in this object's list (-1 if it's not there), so references between components can be saved
+  int GetComponentIndex(const Component *componentPointer) const;
+
+  // Component at the given position of this object's list
+  auto GetComponentAt(int index) const -> std::shared_ptr<Component>;
+
+  int GetComponentCount() const { return components.size(); }
+
   std::string GetName() const { return name; }
 
   std::vector<std::shared_ptr<GameObject>> GetChildren();
@@ -118,14 +128,20 @@ public:
   void SetRotation(const double newRotation);
 
   void SetEnabled(bool enabled) { this->enabled = enabled; }
-  bool IsEnabled() const { return enabled; }
+  bool IsEnabled() const { return enabled && !asleep; }
 
-  // A timer helper
-  Timer timer;
+  // Whether it's region is inactive, in which case it doesn't update, collide or render
+  bool IsAsleep() const { return asleep; }
+
+  // Puts it and it's children to sleep or wakes them up (managed by the state's region grid)
+  void SetAsleep(bool asleep);
 
   // State reference
   GameState &gameState;
 
+  // A timer helper
+  Timer timer;
+
   // Where this object exists in game space, relative to it's parent's position
   Vector2 localPosition;
 
@@ -148,6 +164,9 @@ private:
   // Initialize with given state
   GameObject(std::string name, GameState &gameState);
 
+  // Initialize with given state & id (used when rebuilding it from a snapshot)
+  GameObject(std::string name, GameState &gameState, int id);
+
   // Whether this is the root object
   bool IsRoot() const { return id == 0; }
 
@@ -160,8 +179,10 @@ private:
   // Deletes reference to parent and paren't reference to self
   void UnlinkParent();
 
-  // Announces collision to all components
-  void OnCollision(GameObject &other);
+  // Announces collision contacts to all components
+  void OnCollisionEnter(GameObject &other);
+  void OnCollisionStay(GameObject &other);
+  void OnCollisionExit(GameObject &other);
 
   // Vector with all components of this object
   std::vector<std::shared_ptr<Component>> components;
@@ -180,6 +201,9 @@ private:
 
   // Whether this object is enabled (updating & rendering)
   bool enabled{true};
+
+  // Whether it's region is inactive
+  bool asleep{false};
 };
 
 #include "GameState.h"
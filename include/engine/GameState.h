@@ -1,11 +1,11 @@
 #ifndef __GAME_STATE__
 #define __GAME_STATE__
 
-#include <functional>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <iostream>
+#include <limits>
 #include <SDL.h>
 #include "GameObject.h"
 #include "TileMap.h"
@@ -13,14 +13,43 @@
 #include "Music.h"
 #include "InputManager.h"
 #include "Vector2.h"
+#include "Delegate.h"
+#include "Event.h"
+#include "UpdateScheduler.h"
+#include "RegionGrid.h"
+#include "TileCollisionGrid.h"
+#include "BroadPhase.h"
+#include "CollisionStats.h"
+#include "CollisionMatrix.h"
+#include "SatCollision.h"
+#include "ColliderShape.h"
+#include "BodyType.h"
+#include "Tag.h"
 
 class Component;
 class Collider;
+class Snapshot;
+class BinaryWriter;
+class BinaryReader;
+
+// What a raycast hit first
+struct RaycastHit
+{
+  std::shared_ptr<GameObject> object;
+
+  // Where the ray entered it's collider, and how far along the ray that is
+  Vector2 point;
+  float distance;
+};
+
+// Function which configures a newly created object (big enough to hold the closures returned by Recipes)
+typedef Delegate<void(std::shared_ptr<GameObject>), 96> Recipe;
 
 // Abstract class that defines a state of the game
 class GameState
 {
   friend Collider;
+  friend Snapshot;
 
 public:
   GameState();
@@ -53,7 +82,7 @@ public:
   // Creates a new game object
   template <typename... Args>
   std::shared_ptr<GameObject> CreateObject(
-      std::string name, std::function<void(std::shared_ptr<GameObject>)> recipe = nullptr, Args &&...args)
+      std::string name, const Recipe &recipe = nullptr, Args &&...args)
   {
     // Create the object, which automatically registers it's pointer to the state's list
     int objectId = (new GameObject(name, std::forward<Args>(args)...))->id;
@@ -97,6 +126,15 @@ public:
   // Preloads all the assets so that they are ready when required
   virtual void LoadAssets() {}
 
+  // Writes the state's own data to a snapshot (it's objects are saved separately)
+  virtual void SaveState([[maybe_unused]] BinaryWriter &writer) {}
+
+  // Reads back what SaveState wrote
+  virtual void LoadState([[maybe_unused]] BinaryReader &reader) {}
+
+  // Called once a snapshot is fully restored, to find objects that may have been rebuilt
+  virtual void OnRestore() {}
+
   // Supplies a valid unique identifier for a game object
   int SupplyObjectId() { return nextObjectId++; }
 
@@ -104,9 +142,51 @@ public:
 
   std::shared_ptr<GameObject> GetRootObject() { return rootObject; }
 
+  // Replaces the broad phase, which finds which colliders may be colliding so that only those go through SAT (a SpatialHash by default)
+  void SetBroadPhase(std::unique_ptr<BroadPhase> broadPhase);
+
+  BroadPhase &GetBroadPhase() { return *broadPhase; }
+
+  // Spatial queries, answered from the broad phase with colliders as they were on the last collision detection (asleep ones aren't found)
+  // Layer masks have bit i set to find colliders of layer i, and objects being destroyed are left out
+
+  // Finds the objects with a collider overlapping the rectangle (whose x & y are it's center) rotated by the given radians
+  void QueryBox(const Rectangle &box, float rotation, std::vector<std::shared_ptr<GameObject>> &objects, uint32_t layerMask = ~0u);
+
+  // Finds the objects with a collider overlapping the circle
+  void QueryCircle(Vector2 center, float radius, std::vector<std::shared_ptr<GameObject>> &objects, uint32_t layerMask = ~0u);
+
+  // Finds the first collider along a ray, returning whether there is one within the max distance
+  bool Raycast(Vector2 origin, Vector2 direction, float maxDistance, RaycastHit &hit, uint32_t layerMask = ~0u);
+
+  // Finds up to count objects of the tag whose colliders are closest to the position, nearest first
+  void FindNearest(Vector2 position, Tag tag, int count, std::vector<std::shared_ptr<GameObject>> &objects,
+                   float maxDistance = std::numeric_limits<float>::max());
+
+  // Schedules the timed callbacks of the state and it's objects (declared first so it outlives their timers)
+  TimingWheel timingWheel;
+
   // A timer helper
   Timer timer;
 
+  // Deferred events, dispatched at the end of each update
+  EventQueue eventQueue;
+
+  // Lowers the update rate of components away from the camera view
+  UpdateScheduler updateScheduler;
+
+  // Puts objects far from the action to sleep (only once configured by the state)
+  RegionGrid regionGrid;
+
+  // Which tiles block movement (empty until the state builds it from it's tilemap)
+  TileCollisionGrid tileGrid;
+
+  // Which collision layers are tested against each other (all of them by default)
+  CollisionMatrix collisionMatrix;
+
+  // How much work collision detection does
+  CollisionStats collisionStats;
+
 protected:
   // Reference to input manager
   InputManager &inputManager;
@@ -125,15 +205,25 @@ protected:
 
 private:
   // Executes this function for each object, cascading down the hierarchy
-  void CascadeDown(std::shared_ptr<GameObject> object, std::function<void(GameObject &)> callback, bool topDown = true);
+  void CascadeDown(GameObject &object, const Delegate<void(GameObject &)> &callback, bool topDown = true);
   void DeleteObjects();
   void DetectCollisions();
 
-  // Adds a new collider to it's corresponding object entry
-  void RegisterCollider(std::shared_ptr<Collider> collider);
+  // Adds a started collider to the registry
+  void RegisterCollider(Collider &collider);
+
+  // Removes a collider from the registry, filling it's place with the last one (does nothing if it isn't registered)
+  void UnregisterCollider(Collider &collider);
+
+  // Finds the objects with a collider overlapping the shape
+  void QueryShape(ColliderShape shape, const OrientedBox &box, std::vector<std::shared_ptr<GameObject>> &objects, uint32_t layerMask);
 
-  // Removes any expired colliders from structure & returns the remaining ones as shared
-  std::unordered_map<int, std::vector<std::shared_ptr<Collider>>> ValidateColliders();
+  // Appends the objects of the query object ids, each once, leaving out those being destroyed
+  void AppendQueriedObjects(std::vector<std::shared_ptr<GameObject>> &objects);
+
+  // Caches the world boxes of the awake colliders, updating their proxies (asleep ones lose theirs)
+  // Static colliders are only read when they get a proxy, and still ones keep theirs as it was
+  void GatherColliders();
 
   // Whether the state has executed the start method
   bool started{false};
@@ -145,8 +235,126 @@ private:
   std::unordered_map<RenderLayer, std::vector<std::weak_ptr<Component>>>
       layerStructure;
 
-  // Structure that maps each object id to the list of it's colliders
-  std::unordered_map<int, std::vector<std::weak_ptr<Collider>>> colliderStructure;
+  // A registered collider, with what collision detection needs of it as of the last detection
+  struct ColliderEntry
+  {
+    Collider *collider;
+
+    // It's object (registrations end before objects go)
+    GameObject *object;
+
+    // Broad phase proxy (-1 while it has none)
+    int proxy;
+
+    // World box, with it's rotation
+    OrientedBox box;
+
+    CollisionLayer layer;
+
+    // It's shape, the radius of it's bounding circle, and whether it's an unrotated box (which decide how cheaply it can be tested)
+    ColliderShape shape;
+    float radius;
+    bool axisAligned;
+
+    // How much it moved since the previous detection, if it's continuous (it's box is where it ended up)
+    Vector2 motion;
+
+    // Bounds of it's proxy
+    Bounds bounds;
+
+    BodyType bodyType;
+
+    // Detections in a row it's box stayed the same for
+    int stillFrames;
+
+    // Whether it's a dynamic collider that stayed still long enough to sleep (unlike objects put to sleep by the region grid, it keeps it's proxy)
+    bool IsSleeping() const { return bodyType == BodyType::Dynamic && stillFrames >= sleepFrames; }
+
+    // Static or sleeping: it didn't move, so it's pairs with others that didn't either need no test
+    bool IsResting() const { return bodyType == BodyType::Static || IsSleeping(); }
+  };
+
+  // Detections in a row a dynamic collider must stay still for to sleep
+  static const int sleepFrames;
+
+  // Every registered collider, kept contiguous (each knows it's index here)
+  std::vector<ColliderEntry> colliders;
+
+  // Index of the collider of each proxy (-1 for unused proxies)
+  std::vector<int> colliderOfProxy;
+
+  // Colliders with a proxy on the last detection
+  int awakeColliderCount{0};
+
+  // Destroys the proxy of a registered collider
+  void DestroyProxy(ColliderEntry &entry);
+
+  std::unique_ptr<BroadPhase> broadPhase;
+
+  // Bounds around every proxy on the last detection
+  Bounds colliderBounds;
+
+  // Length of the pieces raycasts query the broad phase with, one after the other
+  static const float raycastPieceLength;
+
+  // Radius nearest object searches start from, doubling until they find enough
+  static const float nearestSearchRadius;
+
+  // Buffers for queries
+  std::vector<int> queryProxies;
+  std::vector<int> queryObjectIds;
+  std::vector<std::pair<int, float>> nearestCandidates;
+
+  // Two objects found colliding, and the earliest fraction of the frame's motion at which they touch
+  struct Hit
+  {
+    // Their ids & the objects themselves, lowest id first
+    std::pair<int, int> objects;
+    GameObject *object1, *object2;
+
+    float time;
+
+    static Hit Between(GameObject *object1, GameObject *object2, float time)
+    {
+      if (object2->id < object1->id)
+        std::swap(object1, object2);
+
+      return Hit{{object1->id, object2->id}, object1, object2, time};
+    }
+  };
+
+  // What a narrow phase worker finds & works with (aligned apart, so that workers don't share cache lines)
+  struct alignas(64) NarrowOutput
+  {
+    std::vector<Hit> hits;
+
+    // Second colliders' boxes & objects of the pairs of a group left for SAT, and whether each collides
+    OrientedBoxBatch batch;
+    std::vector<GameObject *> batchSeconds;
+    std::vector<uint8_t> results;
+
+    size_t sweptTests, circleRejections, shapeTests, boxRejections, satTests;
+
+    void Clear();
+  };
+
+  // Fewest narrow phase pairs worth splitting among workers
+  static const int parallelNarrowPairs;
+
+  // Runs the narrow phase on a range of the narrow pairs (a worker's share)
+  void TestNarrowPairs(size_t start, size_t end, NarrowOutput &output);
+
+  // Buffers for collision detection (kept around to reuse their memory)
+  std::vector<std::pair<int, int>> candidatePairs;
+
+  // Registry indices of the colliders of each pair to test
+  std::vector<std::pair<int, int>> narrowPairs;
+  std::vector<NarrowOutput> narrowOutputs;
+  std::vector<Hit> hits;
+
+  // Pairs of objects in contact on the last detection (sorted), to tell new contacts from lasting ones
+  std::vector<std::pair<int, int>> contacts;
+  std::vector<std::pair<int, int>> newContacts;
 };
 
 #include "Component.h"
@@ -7,6 +7,8 @@
 #include <memory>
 #include <string>
 #include <SDL.h>
+#include "Random.h"
+#include "Diagnostics.h"
 
 namespace Helper
 {
@@ -14,21 +16,6 @@ namespace Helper
   template <class T>
   using auto_unique_ptr = std::unique_ptr<T, void (*)(T *)>;
 
-  // Throws exception if condition is false
-  [[maybe_unused]] static void Assert(bool condition, std::string message, std::string explanation)
-  {
-    if (condition == false)
-    {
-      throw std::runtime_error(message + ". Reported error: " + explanation);
-    }
-  }
-
-  // Throws exception if condition is false
-  [[maybe_unused]] static void Assert(bool condition, std::string message)
-  {
-    Assert(condition, message, SDL_GetError());
-  }
-
   // Splits the given string into an array of strings, using the given delimiter as the separator token
   [[maybe_unused]] static auto SplitString(std::string text, std::string delimiter) -> std::vector<std::string>
   {
@@ -68,12 +55,9 @@ namespace Helper
   [[maybe_unused]] static double DegreesToRadians(double degrees) { return degrees / 180 * M_PI; }
 
   // Gets a random number in the range [min, max[
-  [[maybe_unused]] static int RandomRange(int min, int max) { return min + rand() % (max - min); }
+  [[maybe_unused]] static int RandomRange(int min, int max) { return min + Random::Next() % (max - min); }
   // Gets a random number in the range [min, max[
-  [[maybe_unused]] static float RandomRange(float min, float max)
-  {
-    return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
-  }
+  [[maybe_unused]] static float RandomRange(float min, float max) { return min + Random::NextFloat() * (max - min); }
 
   // Gets a random valid index of the array
   template <typename T>
@@ -3,8 +3,10 @@
 
 #include "Vector2.h"
 #include <iostream>
+#include <string>
 #include <unordered_map>
 #include <SDL.h>
+#include "InputScript.h"
 
 #define LEFT_ARROW_KEY SDLK_LEFT
 #define RIGHT_ARROW_KEY SDLK_RIGHT
@@ -12,6 +14,10 @@
 #define DOWN_ARROW_KEY SDLK_DOWN
 #define ESCAPE_KEY SDLK_ESCAPE
 #define SPACE_KEY SDLK_SPACE
+#define BACKSPACE_KEY SDLK_BACKSPACE
+#define R_KEY SDLK_r
+#define F5_KEY SDLK_F5
+#define F9_KEY SDLK_F9
 #define LEFT_MOUSE_BUTTON SDL_BUTTON_LEFT
 #define RIGHT_MOUSE_BUTTON SDL_BUTTON_RIGHT
 
@@ -26,6 +32,10 @@ public:
     return instance;
   }
 
+  // Copies would miss the input read after they're made
+  InputManager(const InputManager &) = delete;
+  InputManager &operator=(const InputManager &) = delete;
+
   void Update();
 
   bool KeyPress(int key) { return keyState[key] == true && keyUpdate[key] == updateCounter; }
@@ -48,11 +58,17 @@ public:
 
   bool QuitRequested() const { return quitRequested; }
 
+  // Reads the input from a script file instead of the devices
+  void PlayScript(const std::string &path) { script.Load(path); }
+
 private:
   // Default constructor
   // No need for constructor since all values were initialized in class definition
   InputManager() {}
 
+  // Applies an input event to the states
+  void HandleEvent(const SDL_Event &event);
+
   // Mouse state flags
   bool mouseState[6]{};
 
@@ -66,13 +82,16 @@ private:
   // Whether user has requested to quit
   bool quitRequested{false};
 
-  int updateCounter;
+  int updateCounter{0};
 
   // Mouse X coordinates
-  int mouseX;
+  int mouseX{0};
 
   // Mouse Y coordinates
-  int mouseY;
+  int mouseY{0};
+
+  // Input played instead of the devices' (if loaded)
+  InputScript script;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef __INPUT_SCRIPT__
+#define __INPUT_SCRIPT__
+
+#include <string>
+#include <vector>
+#include <SDL.h>
+
+// Input read from a file instead of the devices, so that a run can be repeated exactly (such as a headless one)
+// Each line of the file is "<frame> <action> [arguments]", frames being counted from the first input update:
+//   press <key> / release <key>   (keys by their SDL name, such as Space, F5 or W)
+//   click <left|right> / unclick <left|right>
+//   mouse <x> <y>                 (moves the cursor to these screen coordinates)
+//   quit
+// Empty lines & lines starting with # are ignored
+class InputScript
+{
+public:
+  // Reads the actions of a script file, throwing if it's malformed
+  void Load(const std::string &path);
+
+  bool IsLoaded() const { return loaded; }
+
+  // Gives the next event due by the frame, returning false once there are none left for it
+  bool PollEvent(int frame, SDL_Event &event);
+
+private:
+  // An event & the frame it's given at
+  struct Action
+  {
+    int frame;
+    SDL_Event event;
+  };
+
+  bool loaded{false};
+
+  // Actions sorted by frame
+  std::vector<Action> actions;
+
+  // Index of the next action to give
+  size_t nextAction{0};
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __RANDOM__
+#define __RANDOM__
+
+#include <cstdint>
+
+// The engine's random number generator (xorshift64*), whose whole state is a single number so it can be saved & restored
+class Random
+{
+public:
+  static void Seed(uint64_t seed);
+
+  // Next 32 random bits
+  static uint32_t Next();
+
+  // Random float in the range [0, 1[
+  static float NextFloat() { return (Next() >> 8) * (1.0f / (1 << 24)); }
+
+  static uint64_t GetState() { return state; }
+  static void SetState(uint64_t newState) { state = newState; }
+
+private:
+  static uint64_t state;
+};
+
+#endif
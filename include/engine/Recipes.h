@@ -18,12 +18,12 @@ public:
 
   // Aliens
   static void Alien(std::shared_ptr<GameObject> alien);
-  static auto Minion(std::shared_ptr<::Alien> alien, float startingArc) -> std::function<void(std::shared_ptr<GameObject>)>;
+  static auto Minion(std::shared_ptr<::Alien> alien, float startingArc) -> Recipe;
 
   // General
-  static auto Text(std::string text, int size = 10, Color color = Color::White(), Text::Style style = Text::Style::solid) -> std::function<void(std::shared_ptr<GameObject>)>;
-  static auto Background(std::string imagePath) -> std::function<void(std::shared_ptr<GameObject>)>;
-  static auto OneShotAnimation(std::string spritePath, Vector2 animationFrame, float animationSpeed) -> std::function<void(std::shared_ptr<GameObject>)>;
+  static auto Text(std::string text, int size = 10, Color color = Color::White(), Text::Style style = Text::Style::solid) -> Recipe;
+  static auto Background(std::string imagePath) -> Recipe;
+  static auto OneShotAnimation(std::string spritePath, Vector2 animationFrame, float animationSpeed) -> Recipe;
 
   // Projectile
   static auto Projectile(std::string spritePath, Vector2 animationFrame, float animationSpeed, bool loopAnimation,
@@ -34,7 +34,7 @@ public:
                          float damage = 50.0f,
                          std::weak_ptr<GameObject> target = std::weak_ptr<GameObject>(),
                          float chaseSteering = 0.5f)
-      -> std::function<void(std::shared_ptr<GameObject>)>;
+      -> Recipe;
 };
 
 #endif
\ No newline at end of file
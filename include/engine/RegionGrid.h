@@ -0,0 +1,75 @@
+#ifndef __REGION_GRID__
+#define __REGION_GRID__
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Vector2.h"
+
+class GameObject;
+
+// Splits the world into square regions of tiles, and puts objects to sleep while their region is far from the camera
+// and from every anchor object, so that simulation cost follows the active area instead of the world size
+// Only top level objects created after it's configured are tracked (their children sleep along with them)
+class RegionGrid
+{
+public:
+  // Sets up the grid
+  // origin: world position of the corner of tile (0, 0)
+  // activationRadius: how far from the camera center and from anchors regions are kept active
+  void Configure(Vector2 origin, Vector2 tileSize, int tilesPerRegion, float activationRadius);
+
+  bool IsConfigured() const { return configured; }
+
+  // Keeps the regions around this object active
+  void AddAnchor(std::shared_ptr<GameObject> anchor) { anchors.push_back(anchor); }
+
+  // Starts tracking a newly created object (ignored if not configured)
+  void Track(std::shared_ptr<GameObject> object);
+
+  // Finds the active regions, putting objects to sleep or waking them up as their regions change
+  void Update(Vector2 cameraCenter);
+
+  // How many regions are active
+  int GetActiveCount() const { return activeRegions.size(); }
+
+private:
+  // Key of the region containing this position
+  int64_t GetKey(Vector2 position) const;
+
+  // Adds the key of every region within the activation radius of the position
+  void ActivateAround(Vector2 position);
+
+  // Sets the sleep state of every object of a region
+  void SetRegionAsleep(int64_t key, bool asleep);
+
+  // Moves awake objects which changed regions to their new region
+  void RelocateObjects(int64_t key);
+
+  bool configured{false};
+
+  Vector2 origin;
+
+  // Size of a region, in world units
+  Vector2 regionSize;
+
+  float activationRadius{0.0f};
+
+  // Objects whose regions are kept active
+  std::vector<std::weak_ptr<GameObject>> anchors;
+
+  // Objects tracked since the last update
+  std::vector<std::weak_ptr<GameObject>> newObjects;
+
+  // Objects in each region
+  std::unordered_map<int64_t, std::vector<std::weak_ptr<GameObject>>> regions;
+
+  // Keys of the active regions, sorted
+  std::vector<int64_t> activeRegions;
+
+  // Buffers for the update (kept around to reuse their memory)
+  std::vector<int64_t> nextActiveRegions, changedRegions;
+};
+
+#endif
@@ -1,13 +1,13 @@
 #ifndef __RESOURCES__
 #define __RESOURCES__
 
-#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <SDL.h>
 #include <SDL_mixer.h>
 #include <SDL_ttf.h>
 #include "Helper.h"
+#include "Delegate.h"
 
 class Resources
 {
@@ -43,7 +43,7 @@ private:
       std::string resourceType,
       std::string resourceKey,
       table<Resource> &table,
-      std::function<Resource *(std::string)> resourceLoader,
+      const Delegate<Resource *(std::string)> &resourceLoader,
       void (*resourceDestructor)(Resource *))
   {
     // Check if it's already loaded
@@ -59,7 +59,7 @@ private:
     Resource *resourcePointer = resourceLoader(resourceKey);
 
     // Catch any errors
-    Assert(resourcePointer != nullptr, "Failed to load " + resourceType + " at " + resourceKey);
+    CHECK(resourcePointer != nullptr, "Failed to load ", resourceType, " at ", resourceKey, ". Reported error: ", SDL_GetError());
 
     // Store the texture (create the pointer with the destructor)
     table.emplace(
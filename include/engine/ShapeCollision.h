@@ -0,0 +1,34 @@
+#ifndef __SHAPE_COLLISION__
+#define __SHAPE_COLLISION__
+
+#include "ColliderShape.h"
+#include "SatCollision.h"
+#include "Bounds.h"
+
+// Collision tests between collider shapes, each fitted into an oriented box
+// Pairs with a round shape get a specialized distance test, and pairs of boxes go through SAT
+namespace ShapeCollision
+{
+  bool IsColliding(ColliderShape shape1, const OrientedBox &box1, ColliderShape shape2, const OrientedBox &box2);
+
+  // How far apart the shapes are (not above 0 when they collide)
+  // Exact for pairs with a round shape, and a lower bound for two boxes
+  float FindDistance(ColliderShape shape1, const OrientedBox &box1, ColliderShape shape2, const OrientedBox &box2);
+
+  // Sweeps both shapes along their motion, from the given boxes (without turning), and finds the earliest time they touch
+  // Returns a fraction of the motion, or -1 if they never touch
+  float FindTimeOfImpact(ColliderShape shape1, const OrientedBox &box1, Vector2 motion1,
+                         ColliderShape shape2, const OrientedBox &box2, Vector2 motion2);
+
+  // Distance along a ray (with a unit direction) to where it enters the shape, or -1 if it doesn't within the max distance
+  // Rays starting inside the shape hit it at 0
+  float Raycast(ColliderShape shape, const OrientedBox &box, Vector2 origin, Vector2 direction, float maxDistance);
+
+  // Axis aligned bounds of the shape
+  Bounds BoundsOf(ColliderShape shape, const OrientedBox &box);
+
+  // Radius of the smallest circle around the shape, from the center of it's box
+  float BoundingRadiusOf(ColliderShape shape, float width, float height);
+}
+
+#endif
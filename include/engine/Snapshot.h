@@ -0,0 +1,113 @@
+#ifndef __SNAPSHOT__
+#define __SNAPSHOT__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TimingWheel.h"
+
+class GameState;
+class GameObject;
+class BinaryWriter;
+class BinaryReader;
+
+// Copy of a state's world at some moment: it's objects & their components, timers, the camera and the random generator
+// Restoring it updates objects that still exist in place, removes the ones created after it,
+// and rebuilds the ones destroyed after it (their component types must be registered with REGISTER_COMPONENT)
+// Snapshots captured without callbacks can be written to scene files, and read back in a later run
+class Snapshot
+{
+public:
+  // Identifies scene files
+  static const uint32_t fileMagic;
+
+  // Version of the scene file layout (raise it whenever the layout or a component's saved data changes)
+  static const uint32_t fileVersion;
+
+  Snapshot() {}
+
+  Snapshot(const Snapshot &) = delete;
+  Snapshot &operator=(const Snapshot &) = delete;
+
+  // Saves the state's current world (call it between frames)
+  // Without callbacks, timed callbacks are left out, and restoring it cancels all of them
+  void Capture(GameState &state, bool withCallbacks = true);
+
+  // Brings the state's world back to how it was when captured
+  void Restore(GameState &state);
+
+  bool IsEmpty() const { return data.empty(); }
+
+  // How many bytes it takes, not counting the timing wheel
+  size_t GetSize() const { return data.size(); }
+
+  // Writes it to a scene file (it must have been captured without callbacks)
+  void WriteFile(const std::string &path) const;
+
+  // Reads a scene file, so that it can be restored
+  void ReadFile(const std::string &path);
+
+private:
+  // Where an object's record starts in the data
+  struct ObjectRecord
+  {
+    int id;
+    size_t offset;
+  };
+
+  void SaveObject(GameObject &object, BinaryWriter &writer);
+
+  // Reads an object's record back into it, constructing it's components first if it's being rebuilt
+  // Returns the id of it's parent
+  int LoadObject(GameObject &object, BinaryReader &reader, bool rebuild);
+
+  // Whether the object has exactly the component types of the record, so it can be restored in place
+  bool Matches(GameObject &object, const ObjectRecord &record) const;
+
+  // Saved bytes
+  std::vector<uint8_t> data;
+
+  // Records of the saved objects, sorted by id
+  std::vector<ObjectRecord> objects;
+
+  // Copy of the state's timing wheel, which holds the timed callbacks of all timers
+  TimingWheel wheel;
+
+  // Whether it was captured with the timed callbacks
+  bool withCallbacks{true};
+
+  // Reused while capturing & restoring
+  std::vector<GameObject *> objectBuffer;
+  std::vector<int> parentIds;
+  std::vector<bool> rebuilt;
+  std::vector<int> typeIdBuffer;
+};
+
+// Keeps snapshots of the last frames, so that the state can be rewound
+class RollbackBuffer
+{
+public:
+  RollbackBuffer(int capacity) : snapshots(capacity) {}
+
+  // Captures the state into the oldest snapshot
+  void Record(GameState &state);
+
+  // Restores the snapshot recorded the given amount of records ago, forgetting it & the newer ones
+  // Returns false if there aren't that many records
+  bool Rewind(GameState &state, int frames = 1);
+
+  // How many snapshots are available to rewind to
+  int Count() const { return count; }
+
+  void Clear() { count = 0; }
+
+private:
+  std::vector<Snapshot> snapshots;
+
+  // Index of the newest snapshot
+  int newest{-1};
+
+  int count{0};
+};
+
+#endif
@@ -25,6 +25,9 @@ public:
 
   void Start() override;
 
+  // A rebuilt sound isn't played again, as it already was
+  void SaveConstruction(BinaryWriter &writer) override;
+
 private:
   // The chunk path
   std::string chunkPath;
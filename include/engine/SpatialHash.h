@@ -0,0 +1,57 @@
+#ifndef __SPATIAL_HASH__
+#define __SPATIAL_HASH__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "BroadPhase.h"
+
+// Uniform grid broad phase: each bounds is put in every square cell it overlaps, and only bounds sharing a cell are paired
+// Cells are keyed by their coordinates, and entries are grouped by sorting their keys, so the grid is unbounded
+// and keeps no per cell storage between frames
+// Best when objects are about the same size
+class SpatialHash : public BroadPhase
+{
+public:
+  // Cell size used unless configured otherwise
+  static const float defaultCellSize;
+
+  SpatialHash(float cellSize = defaultCellSize) { SetCellSize(cellSize); }
+
+  // Cells should be about as large as the common objects: smaller ones make large objects span many cells,
+  // larger ones put many objects in the same cell
+  void SetCellSize(float cellSize);
+
+  float GetCellSize() const { return cellSize; }
+
+  int CreateProxy(const Bounds &bounds) override;
+  void MoveProxy(int proxy, const Bounds &bounds) override;
+  void DestroyProxy(int proxy) override;
+  void FindPairs(std::vector<std::pair<int, int>> &pairs) override;
+  void Query(const Bounds &bounds, std::vector<int> &proxies) override;
+
+private:
+  // A proxy in a cell
+  struct Entry
+  {
+    int64_t cellKey;
+    int proxy;
+  };
+
+  // Column (or row) of the cells containing the coordinate
+  int GetCell(float coordinate) const;
+
+  float cellSize;
+
+  // Bounds of each proxy, and whether it's in use
+  std::vector<Bounds> proxies;
+  std::vector<bool> used;
+
+  // Ids of destroyed proxies, to be reused
+  std::vector<int> freeProxies;
+
+  // Reused from one search to the next
+  std::vector<Entry> entries;
+};
+
+#endif
@@ -59,7 +59,14 @@ public:
 
   int GetRenderOrder() override { return renderOrder; }
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
 private:
+  // Path of the loaded image (empty if none was loaded)
+  std::string path;
+
   // The loaded texture
   std::shared_ptr<SDL_Texture> texture;
 
@@ -12,7 +12,7 @@ class SpriteAnimator : public Component
 {
 public:
   SpriteAnimator(GameObject &associatedObject, std::weak_ptr<Sprite> sprite, Vector2 frameDimensions, float secondsPerFrame, bool loop = false)
-      : Component(associatedObject), loop(loop), spriteWeak(sprite), frameDimensions(frameDimensions), secondsPerFrame(secondsPerFrame)
+      : Component(associatedObject), OnCycleEnd(gameState.eventQueue), loop(loop), spriteWeak(sprite), frameDimensions(frameDimensions), secondsPerFrame(secondsPerFrame)
   {
     ConfigureSpriteFrames();
   }
@@ -20,6 +20,7 @@ public:
   virtual ~SpriteAnimator() {}
   
   void Update(float deltaTime) override;
+  UpdateRate GetMinUpdateRate() override { return UpdateRate::Eighth; }
 
   // Get how many frames the animation has
   int GetFrameCount() { return rowFrameCount * columnFrameCount; }
@@ -33,12 +34,22 @@ public:
   float GetFrameWidth() { return frameDimensions.x; }
   float GetFrameHeight() { return frameDimensions.y; }
 
-  // Triggered on animation cycle end
+  // Triggered on animation cycle end (deferred to the end of the frame)
   Event OnCycleEnd;
 
   // Whether to loop
   bool loop{false};
 
+  // Destroys it's object once the animation cycle ends, with an OnCycleEnd listener
+  void DestroyObjectOnCycleEnd();
+
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
+  // Listeners can't be saved, so the one destroying the object is subscribed again
+  void OnRestore() override;
+
 private:
   void ConfigureSpriteFrames();
 
@@ -65,6 +76,12 @@ private:
 
   // Whether animation is playing
   bool playing{true};
+
+  // Whether the object is destroyed once the cycle ends
+  bool destroyObjectOnCycleEnd{false};
+
+  // Handle of the listener which destroys the object (-1 while it isn't subscribed)
+  ListenerHandle destroyListener{-1};
 };
 
 #endif
\ No newline at end of file
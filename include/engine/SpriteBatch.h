@@ -0,0 +1,66 @@
+#ifndef __SPRITE_BATCH__
+#define __SPRITE_BATCH__
+
+#include <cstddef>
+#include <vector>
+#include <SDL.h>
+
+// Gathers textured quads into vertex arrays, submitting each run of quads sharing a texture & blend mode with a single
+// SDL_RenderGeometry call, instead of one SDL_RenderCopyEx per sprite
+// Quads are never reordered: a batch is only broken when the texture or it's blend mode changes, so drawing order is kept
+class SpriteBatch
+{
+public:
+  // Counters of a frame, or sums of many
+  struct Counter
+  {
+    // Quads drawn (each would have been a draw call by itself)
+    size_t sprites{0};
+
+    // Geometry submissions
+    size_t drawCalls{0};
+
+    void Add(const Counter &other);
+  };
+
+  // Whether the game prints the report when it ends
+  static void SetReporting(bool reporting);
+
+  // Queues the clip of the texture, stretched to the destination & rotated (in radians) around it's center
+  void Draw(SDL_Texture *texture, const SDL_Rect &clip, const SDL_Rect &destination, float rotation = 0.0f);
+
+  // Submits the queued quads
+  // Must be called before drawing anything to the renderer by other means, so that it lands on top of them
+  void Flush();
+
+  // Flushes & closes the current frame, adding it to the totals
+  void EndFrame();
+
+  // Counters of the last closed frame
+  const Counter &GetLastFrame() const { return lastFrame; }
+
+  // Prints the averages per frame (if reporting)
+  void Report() const;
+
+private:
+  static bool reporting;
+
+  // Texture & blend mode of the queued quads
+  SDL_Texture *texture{nullptr};
+  SDL_BlendMode blendMode{SDL_BLENDMODE_NONE};
+
+  // Dimensions of that texture, to turn clips into texture coordinates
+  float textureWidth{1}, textureHeight{1};
+
+  // Corners of the queued quads, 4 each
+  std::vector<SDL_Vertex> vertices;
+
+  // Two triangles per quad (only ever grows, as they don't depend on the quads)
+  std::vector<int> indices;
+
+  Counter frame, lastFrame, total;
+
+  int frames{0};
+};
+
+#endif
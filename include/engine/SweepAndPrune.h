@@ -0,0 +1,86 @@
+#ifndef __SWEEP_AND_PRUNE__
+#define __SWEEP_AND_PRUNE__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "BroadPhase.h"
+
+// Sweep and prune broad phase: keeps the ends of every proxy's bounds sorted along each axis, from one frame to the next
+// As objects move little between frames, insertion sort puts the ends back in order with few swaps,
+// and each swap tells exactly which pair started or stopped overlapping, so stable scenes cost about O(n) per frame
+class SweepAndPrune : public BroadPhase
+{
+public:
+  int CreateProxy(const Bounds &bounds) override;
+  void MoveProxy(int proxy, const Bounds &bounds) override;
+  void DestroyProxy(int proxy) override;
+  void FindPairs(std::vector<std::pair<int, int>> &pairs) override;
+  void Query(const Bounds &bounds, std::vector<int> &proxies) override;
+
+  // Pairs which started overlapping since the previous search (lowest id first, sorted)
+  const std::vector<std::pair<int, int>> &GetAddedPairs() const { return addedPairs; }
+
+  // Pairs which stopped overlapping since the previous search, including those of destroyed proxies
+  const std::vector<std::pair<int, int>> &GetRemovedPairs() const { return removedPairs; }
+
+  // How many swaps the last search took to sort the ends
+  int GetSwapCount() const { return swapCount; }
+
+private:
+  // An end of a proxy's bounds along an axis
+  struct Endpoint
+  {
+    float value;
+    int proxy;
+    bool isMax;
+  };
+
+  // Whether the endpoint goes before the other one (at equal values, starts go before ends, as touching bounds overlap)
+  static bool Before(const Endpoint &endpoint, const Endpoint &other)
+  {
+    return endpoint.value < other.value || (endpoint.value == other.value && endpoint.isMax == false && other.isMax);
+  }
+
+  // Refreshes the values of the endpoints of an axis
+  void RefreshAxis(int axis);
+
+  // Sorts the ends of an axis, recording the pairs which changed
+  void SortAxis(int axis);
+
+  // Sorts the ends from scratch & sweeps them to find every pair, recording the changes (used when many proxies were created at once)
+  void Rebuild();
+
+  static int64_t MakeKey(int proxy1, int proxy2);
+
+  // Bounds of each proxy, and whether it's in use
+  std::vector<Bounds> proxies;
+  std::vector<bool> used;
+
+  // Ids of destroyed proxies, to be reused
+  std::vector<int> freeProxies;
+
+  // Sorted ends of each axis
+  std::vector<Endpoint> endpoints[2];
+
+  // Keys of the overlapping pairs, sorted
+  std::vector<int64_t> pairKeys;
+
+  // Changes found while sorting, and pairs lost to destroyed proxies
+  std::vector<int64_t> addedKeys, removedKeys, destroyedKeys, mergeBuffer;
+
+  std::vector<std::pair<int, int>> addedPairs, removedPairs;
+
+  // Proxies created since the previous search
+  int createdCount{0};
+
+  int swapCount{0};
+
+  // Widest bounds at the last search, which tells how far before a query the starts of overlapping proxies can be
+  float maxWidth{0};
+
+  // Proxies whose start was swept but not their end, during a rebuild
+  std::vector<int> sweepActive;
+};
+
+#endif
@@ -43,6 +43,10 @@ public:
 
   // Getters aren't necessary yet so weren't implemented
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
 private:
   // Remakes the texture according to the new text settings
   void RemakeTexture();
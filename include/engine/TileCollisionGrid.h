@@ -0,0 +1,56 @@
+#ifndef __TILE_COLLISION_GRID__
+#define __TILE_COLLISION_GRID__
+
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+#include "Bounds.h"
+
+class TileMap;
+
+// Tells which tiles of a tilemap layer block movement, one flag per cell, so that level geometry needs no colliders
+// Finding the cell of a position is a division, and checking it a single lookup, whatever the size of the map
+class TileCollisionGrid
+{
+public:
+  // Builds it from a layer of the tilemap (with it's object's position as the map's center)
+  // solidTiles: whether each tileset index is solid (indices past it's end, and empty tiles, aren't)
+  // outsideSolid: whether the cells around the map are solid, walling it in
+  void Build(const TileMap &tileMap, int layer, const std::vector<bool> &solidTiles, bool outsideSolid = false);
+
+  bool IsBuilt() const { return columns > 0; }
+
+  // Column & row of the cell containing the coordinate (may be outside the map)
+  int GetColumn(float x) const;
+  int GetRow(float y) const;
+
+  // Whether the cell blocks movement
+  bool IsSolid(int column, int row) const;
+
+  bool IsSolidAt(Vector2 position) const { return IsSolid(GetColumn(position.x), GetRow(position.y)); }
+
+  // Whether any solid cell overlaps the bounds
+  bool Overlaps(const Bounds &bounds) const;
+
+  // Moves the bounds by the motion, along x then along y, stopping each at the first solid cell it would enter
+  // Returns the motion left (solid cells it already overlaps don't stop it, so that it can get out of them)
+  Vector2 Resolve(const Bounds &bounds, Vector2 motion) const;
+
+private:
+  // How far the bounds can go along an axis (0 for x, 1 for y) before entering a solid cell
+  float SweepAxis(const Bounds &bounds, float distance, int axis) const;
+
+  // Corner of cell (0, 0)
+  Vector2 origin;
+
+  Vector2 cellSize;
+
+  int columns{0}, rows{0};
+
+  bool outsideSolid{false};
+
+  // Whether each cell is solid, row by row
+  std::vector<uint8_t> solid;
+};
+
+#endif
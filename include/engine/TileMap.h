@@ -22,6 +22,12 @@ public:
       std::shared_ptr<TileSet> tileSet, int onlyLayer = -1,
       RenderLayer renderLayer = RenderLayer::Tilemap);
 
+  // Constructor with the tiles already loaded (width * height tiles for each layer, one layer after the other)
+  TileMap(
+      GameObject &associatedObject, int width, int height, int depth, std::vector<int> tiles,
+      std::shared_ptr<TileSet> tileSet, int onlyLayer = -1,
+      RenderLayer renderLayer = RenderLayer::Tilemap);
+
   virtual ~TileMap() {}
 
   // Loads a map configuration file
@@ -33,6 +39,8 @@ public:
   // Returns a reference to the tile at the given position
   int &At(int x, int y, int z = 0) { return tileMatrix[x + y * mapWidth + z * mapWidth * mapHeight]; }
 
+  int At(int x, int y, int z = 0) const { return tileMatrix[x + y * mapWidth + z * mapWidth * mapHeight]; }
+
   int &At(Vector2 position, int layer) { return At((int)position.x, (int)position.y, layer); }
 
   // Renders a given layer
@@ -53,6 +61,16 @@ public:
 
   RenderLayer GetRenderLayer() override { return renderLayer; }
 
+  // The tiles are saved as they are, so that loading them is a single copy
+  void SaveConstruction(BinaryWriter &writer) override;
+
+  // Writes which object holds the tileset
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
+  // Gets a tileset for the tileset object, in case either was rebuilt
+  void OnRestore() override;
+
 private:
   std::vector<int> tileMatrix;
 
@@ -73,6 +91,10 @@ private:
 
   // Which tilemap layer to render (if -1, renders all)
   int targetLayer;
+
+  // Tileset read from a snapshot (the id of it's object & it's tile size), found again on restore
+  int restoredTileSetId{-1};
+  Vector2 restoredTileSize;
 };
 
 #endif
\ No newline at end of file
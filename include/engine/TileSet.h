@@ -13,6 +13,10 @@ class TileSet
 public:
   // Default constructor
   TileSet(int tileWidth, int tileHeight, std::string filename);
+
+  // Uses the sprite of an existing tileset object (such as one rebuilt from a snapshot)
+  TileSet(int tileWidth, int tileHeight, std::shared_ptr<GameObject> object);
+
   ~TileSet();
 
   // Render a tile
@@ -24,7 +28,13 @@ public:
   // Get the height of each tile
   int GetTileHeight() const { return tileHeight; }
 
+  // Get the object which holds the tileset sprite
+  std::shared_ptr<GameObject> GetObject() const { return objectWeak.lock(); }
+
 private:
+  // Creates the object which holds the tileset sprite
+  static std::shared_ptr<GameObject> CreateObject(std::string filename);
+
   int tileWidth;
   int tileHeight;
 
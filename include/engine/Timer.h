@@ -1,35 +1,105 @@
 #ifndef __TIMER__
 #define __TIMER__
 
-#include <unordered_map>
 #include <string>
+#include <vector>
+#include "Delegate.h"
+#include "TimingWheel.h"
+#include "BinaryStream.h"
 
+// Precomputed identifier of a named timer (get one with Timer::Intern)
+struct TimerId
+{
+  int value;
+};
+
+// Per object timer helper
+// Stopwatches are read on demand from the state's clock, and timed callbacks are stored in the state's timing wheel,
+// so an object with timers costs nothing per frame
 class Timer
 {
+public:
+  Timer(TimingWheel &wheel) : wheel(wheel) {}
+
+  // Cancels any callbacks still scheduled
+  ~Timer() { CancelAll(); }
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+  // Gets the identifier of a timer name. Intended to be called once, when initializing static constants
+  static TimerId Intern(const std::string &name);
+
+  // Gets the name an identifier was interned from
+  static const std::string &GetName(TimerId id);
+
+  // === STOPWATCHES
+
+  // Sets the stopwatch's value, and whether it's counting
+  void Reset(TimerId id, float value = 0, bool enable = true);
+
+  // Gets the stopwatch's value (0 if it was never reset)
+  float Get(TimerId id) const;
+
+  void Start(TimerId id);
+  void Stop(TimerId id);
+
+  // === TIMED CALLBACKS
+
+  // Calls the callback once, after the given amount of seconds
+  TimerHandle After(float seconds, Delegate<void()> callback);
+
+  // Calls the callback every given amount of seconds
+  TimerHandle Every(float seconds, Delegate<void()> callback);
+
+  // Cancels a scheduled callback
+  void Cancel(TimerHandle handle) { wheel.Cancel(handle); }
+
+  // Cancels all callbacks scheduled by this timer
+  void CancelAll();
+
+  // === SNAPSHOTS
+
+  // Writes the stopwatches & the handles of the scheduled callbacks (the callbacks themselves are saved with the wheel)
+  // Stopwatches are written as their current reading, so they can be loaded against a different clock
+  // Without callbacks, the state may end up in a scene file, so stopwatches are written by name, as ids depend on the
+  // build's static initialization order
+  void SaveState(BinaryWriter &writer, bool withCallbacks = true) const;
+
+  // Reads back what SaveState wrote, with the same withCallbacks
+  void LoadState(BinaryReader &reader, bool withCallbacks = true);
+
+private:
+  // Interned names, indexed by id (a function static, as interning happens during static initialization)
+  static std::vector<std::string> &GetNames();
+
   struct Entry
   {
+    TimerId id;
+
+    // Value accumulated up to the moment it was last started or stopped
     float value{0.0f};
+
+    // Clock time at which it was last started
+    double startTime{0.0};
+
     bool enabled{false};
   };
 
-  std::unordered_map<std::string, Entry> timers;
+  // Gets the entry for this id, creating it if necessary
+  Entry &GetEntry(TimerId id);
 
-public:
-  void
-  Reset(std::string name, float value = 0, bool enable = true)
-  {
-    timers[name].value = value;
-    timers[name].enabled = enable;
-  }
-  float Get(std::string name) { return timers[name].value; }
-  void Start(std::string name) { timers[name].enabled = true; }
-  void Stop(std::string name) { timers[name].enabled = false; }
-  void Update(float deltaTime)
-  {
-    for (auto &entry : timers)
-      if (entry.second.enabled)
-        entry.second.value += deltaTime;
-  }
+  // Keeps track of a scheduled callback, forgetting the ones that already fired
+  TimerHandle Track(TimerHandle handle);
+
+  // The state's timing wheel
+  TimingWheel &wheel;
+
+  // Stopwatch entries (objects have few, so a linear search beats hashing)
+  std::vector<Entry> entries;
+
+  // Callbacks scheduled by this timer
+  std::vector<TimerHandle> scheduled;
 };
 
-#endif
\ No newline at end of file
+#endif
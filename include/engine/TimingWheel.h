@@ -0,0 +1,138 @@
+#ifndef __TIMING_WHEEL__
+#define __TIMING_WHEEL__
+
+#include <cstdint>
+#include <vector>
+#include "Delegate.h"
+
+// Identifies a callback scheduled in a timing wheel
+struct TimerHandle
+{
+  int index{-1};
+  uint32_t generation{0};
+};
+
+// Hierarchical timing wheel: schedules callbacks to fire at a deadline
+// Scheduling, cancelling and firing are constant time, and time with no due callbacks costs next to nothing
+class TimingWheel
+{
+public:
+  // Duration of a wheel tick, in seconds
+  static const double tickDuration;
+
+  // How many levels the wheel has
+  static const int levelCount{4};
+
+  // Bits of a tick used by each level (slots per level is 2^slotBits)
+  static const int slotBits{6};
+
+  TimingWheel();
+
+  // Calls the callback once the given amount of seconds has passed
+  // If period is greater than zero, keeps calling it every period seconds after that
+  // Transient callbacks are dropped when restoring a snapshot (use it for things that aren't saved, like behavior resumes)
+  TimerHandle Schedule(float seconds, Delegate<void()> callback, float period = 0.0f, bool transient = false);
+
+  // Cancels a scheduled callback. Does nothing if it already fired or was cancelled
+  void Cancel(TimerHandle handle);
+
+  // Whether the callback is still going to fire
+  bool IsScheduled(TimerHandle handle) const;
+
+  // Advances time, firing every callback whose deadline is reached
+  void Advance(float deltaTime);
+
+  // Seconds elapsed since the wheel was created
+  double GetTime() const { return time; }
+
+  // How many callbacks are scheduled
+  int Count() const { return scheduledCount; }
+
+  // Goes back to the schedule of a copy taken earlier, dropping it's transient callbacks
+  // Handles given out since the copy was taken remain invalid
+  void Restore(const TimingWheel &copy);
+
+  // Cancels every scheduled callback, keeping the time
+  void Clear();
+
+private:
+  static const int slotCount{1 << slotBits};
+
+  // A scheduled callback
+  struct Entry
+  {
+    Delegate<void()> callback;
+
+    // Tick at which to fire
+    uint64_t deadline{0};
+
+    // Ticks between firings (0 fires once)
+    uint64_t period{0};
+
+    // Neighbours in the list it belongs to
+    int previous{-1};
+    int next{-1};
+
+    // Which list it belongs to (free or firing entries belong to none)
+    int list{noList};
+
+    // Given anew whenever the entry is allocated, and zeroed when released, which invalidates old handles
+    uint32_t generation{0};
+
+    // Whether to drop it when restoring
+    bool transient{false};
+  };
+
+  // List marker for entries which aren't in any slot
+  static const int noList{-1};
+
+  // List which holds the entries being fired this tick
+  static const int dueList{levelCount * slotCount};
+
+  // Puts an entry in the slot matching it's deadline
+  void Insert(int index);
+
+  // Removes an entry from it's list
+  void Unlink(int index);
+
+  // Appends an entry to a list
+  void Link(int index, int list);
+
+  // Reinserts every entry of a slot, moving them to finer levels
+  void Cascade(int level);
+
+  // Fires every entry of the current tick's slot
+  void FireDue();
+
+  // Gets an unused entry
+  int Allocate();
+
+  // Returns an entry to the free list
+  void Release(int index);
+
+  // Converts seconds to ticks (at least one)
+  static uint64_t ToTicks(float seconds);
+
+  // Entry pool
+  std::vector<Entry> entries;
+
+  // Indices of unused entries
+  std::vector<int> freeEntries;
+
+  // First entry of each slot, followed by the due list
+  std::vector<int> heads;
+
+  // Current tick
+  uint64_t currentTick{0};
+
+  // Current time, in seconds
+  double time{0};
+
+  // How many entries are scheduled
+  int scheduledCount{0};
+
+  // Generation to give the next allocated entry (never goes back, so handles are never reused)
+  uint32_t nextGeneration{1};
+};
+
+#endif
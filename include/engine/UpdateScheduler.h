@@ -0,0 +1,85 @@
+#ifndef __UPDATE_SCHEDULER__
+#define __UPDATE_SCHEDULER__
+
+#include <vector>
+#include "Vector2.h"
+
+// How low a component's update rate may drop when it's object is away from the camera view
+// (the value is how many frames may go by between updates)
+enum class UpdateRate
+{
+  Full = 1,
+  Half = 2,
+  Quarter = 4,
+  Eighth = 8
+};
+
+// Counts update activity in a frame
+struct UpdateStats
+{
+  // Updates of components which can't have their rate lowered, or which are on screen
+  int full{0};
+
+  // Updates of components running at a lowered rate
+  int reduced{0};
+
+  // Lowered rate updates skipped because the component wasn't due
+  int skipped{0};
+
+  // Lowered rate updates postponed because the frame's cap was reached
+  int postponed{0};
+};
+
+// Decides how often each component is updated based on it's object's distance to the camera view
+// Components with a lowered rate accumulate the time of the frames they skip, and the amount of lowered rate updates
+// per frame is capped, so that large maps stay within the frame budget
+// Components postponed by the cap have slots kept for them in the next frame, longest waiting first, so none of them
+// is postponed forever just because it comes late in the hierarchy
+class UpdateScheduler
+{
+public:
+  UpdateScheduler();
+
+  // Distances from the camera view past which the rate halves, quarters and drops to an eighth
+  static const float rateDistances[3];
+
+  // How many lowered rate updates may run in a single frame (the remaining are postponed to the next)
+  static const int maxReducedUpdatesPerFrame;
+
+  // Most frames past due that are told apart when giving priority (longer waits count as this)
+  static const int maxOverdueFrames;
+
+  // Starts a frame with the given camera view, in world coordinates
+  void BeginFrame(Vector2 viewTopLeft, Vector2 viewSize);
+
+  // How many frames should go by between updates of an object at this position (1 when visible)
+  int GetInterval(Vector2 position) const;
+
+  // Tells whether a component that has been waiting for this amount of frames may update now
+  // Counts the decision into the frame's stats
+  bool ShouldUpdate(int interval, int waitedFrames);
+
+  // Counters of the last finished frame
+  const UpdateStats &GetLastFrameStats() const { return lastFrameStats; }
+
+private:
+  // Current view bounds
+  Vector2 viewMin, viewMax;
+
+  // Components at least this many frames past due have a slot kept for them
+  int priorityOverdue;
+
+  // How many kept slots are still waiting for their components this frame
+  int reservedUpdates{0};
+
+  // How many components were postponed at each amount of frames past due, this frame
+  std::vector<int> postponedOverdue;
+
+  // Counters of the frame in progress
+  UpdateStats frameStats;
+
+  // Counters of the last finished frame
+  UpdateStats lastFrameStats;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef __WORKER_POOL__
+#define __WORKER_POOL__
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Delegate.h"
+
+// Threads kept around to split a job among, so that they don't have to be started for each one
+// The thread running a job takes part as worker 0, so with no spare cores a job simply runs on it
+class WorkerPool
+{
+public:
+  // Most threads a job is split among, the calling one included
+  static const int maxWorkers;
+
+  static WorkerPool &GetInstance()
+  {
+    static WorkerPool instance;
+
+    return instance;
+  }
+
+  ~WorkerPool();
+
+  // How many workers a job is split among
+  int GetWorkerCount() const { return threads.size() + 1; }
+
+  // Calls the job once on each worker, with that worker's index, and returns once all calls are over
+  // Jobs must not throw, and must only share what they read
+  void Run(const Delegate<void(int)> &job);
+
+private:
+  WorkerPool();
+
+  // Loop of each extra thread
+  void Work(int worker);
+
+  std::vector<std::thread> threads;
+
+  std::mutex mutex;
+  std::condition_variable jobStarted, jobFinished;
+
+  // Job being run, and how many of the extra threads are still on it
+  const Delegate<void(int)> *job{nullptr};
+  int busyThreads{0};
+
+  // Raised with each job, so that threads tell a new one from the one they just ran
+  int jobNumber{0};
+
+  bool stopping{false};
+};
+
+#endif
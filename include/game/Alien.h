@@ -7,6 +7,7 @@
 #include "Health.h"
 #include "Vector2.h"
 #include "Component.h"
+#include "Behavior.h"
 #include <queue>
 #include <vector>
 #include <memory>
@@ -36,22 +37,28 @@ public:
   void OnBeforeDestroy() override;
   void Start() override;
   void Update(float deltaTime) override;
+  UpdateRate GetMinUpdateRate() override { return UpdateRate::Eighth; }
+
+  // Minions rejoin it on their own restore
+  void LoadState(BinaryReader &reader) override;
+
+  // Behaviors can't be saved, so it starts acting anew
+  void OnRestore() override;
 
   // It's current minions
   std::vector<std::weak_ptr<GameObject>> minions;
 
 private:
-  void Chase();
-  void Arrive();
-  void Shoot(Vector2 position);
+  // Idles for a random time, then chases the penguin and shoots at it, over and over
+  Behavior Act();
 
-  enum class State
-  {
-    moving,
-    idle
-  };
+  // Starts moving towards the penguin
+  Movement::Arrival Chase();
+
+  void Shoot(Vector2 position);
 
-  State state{State::idle};
+  // The running Act behavior
+  Behavior behavior;
 
   std::weak_ptr<Movement> movementWeak;
   std::weak_ptr<PenguinBody> penguinWeak;
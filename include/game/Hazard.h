@@ -14,10 +14,13 @@ public:
       
   virtual ~Hazard() {}
 
-  void OnCollision(GameObject &other) override;
+  // Only hurts when contact begins, so lasting contact doesn't hurt every frame
+  void OnCollisionEnter(GameObject &other) override;
 
   float GetDamage() { return damage; }
 
+  void SaveConstruction(BinaryWriter &writer) override;
+
 private:
   // Which tag of object will this projectile collide with
   Tag targetTag;
@@ -12,11 +12,14 @@ public:
 
   virtual ~Health() {}
   
-  // Death event
+  // Death event (deferred to the end of the frame)
   Event OnDeath;
 
   void TakeDamage(float damage);
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
 
 private:
   // Current health status
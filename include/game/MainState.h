@@ -5,12 +5,16 @@
 #include "GameObject.h"
 #include "Alien.h"
 #include "Tilemap.h"
-#include <functional>
+#include "Snapshot.h"
 #include <memory>
+#include <string>
+#include <vector>
 
 class MainState : public GameState
 {
 public:
+  MainState();
+
   virtual ~MainState() {}
 
   // How many aliens to start with
@@ -19,8 +23,23 @@ public:
   // How long to stop state after player dies
   static const float dieAdvanceTime;
 
-  // How much slack the penguin ahs on the edges before dying
-  static const float edgeSlack;
+  // Whether each tileset index blocks movement
+  static const std::vector<bool> solidTiles;
+
+  // How many tiles wide each simulation region is
+  static const int tilesPerRegion;
+
+  // How far from the camera & the penguin regions are kept awake
+  static const float activationRadius;
+
+  // How many frames can be rewound
+  static const int rewindFrames;
+
+  // Scene file written by quick save (F5) & read by quick load (F9)
+  static const std::string quickSavePath;
+
+  // How many times each way of building the scene is timed by the benchmark
+  static const int benchmarkIterations;
 
   void InitializeObjects() override;
 
@@ -28,11 +47,35 @@ public:
 
   void AdvanceState(bool victory);
 
+  // Advances to the end state after a while
+  void OnPlayerDeath();
+
+  // Advances to the end state once all aliens are dead
+  void OnAlienDeath();
+
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+  void OnRestore() override;
+
 private:
+  // Creates the scene's objects from recipes
+  void CreateScene();
+
+  // Times building the scene from recipes against saving it to & restoring it from a scene file
+  void BenchmarkScene();
+
+  // Counts the alien's death when it's health runs out
+  void ListenToAlienDeath(Health &health);
+
   Music music;
 
+  // Scene as it was on the first frame, restored to restart (R)
+  Snapshot initialScene;
+
+  // Snapshots of the last frames, rewound while backspace is held
+  RollbackBuffer rollback{rewindFrames};
+
   std::weak_ptr<GameObject> penguinWeak;
-  std::weak_ptr<TileMap> tilemapWeak;
 
   // How many aliens there still are
   int alienCount{totalAliens};
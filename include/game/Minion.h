@@ -40,10 +40,18 @@ public:
 
   void OnBeforeDestroy() override;
   void Update(float deltaTime) override;
+  UpdateRate GetMinUpdateRate() override { return UpdateRate::Eighth; }
   RenderLayer GetRenderLayer() override { return RenderLayer::None; }
 
   void Shoot(Vector2 target);
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
+  // Finds the host again, and rejoins it's minions
+  void OnRestore() override;
+
 private:
   // Alien object around which to orbit
   std::weak_ptr<GameObject> hostPointer;
@@ -56,6 +64,9 @@ private:
 
   // Whether to float away or towards the center (1 or -1)
   float floatDirection{1};
+
+  // Id of the host, kept while a snapshot is restored (-1 if none)
+  int hostId{-1};
 };
 
 #endif
\ No newline at end of file
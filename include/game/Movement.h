@@ -1,29 +1,65 @@
 #ifndef __MOVEMENT__
 #define __MOVEMENT__
 
-#include <functional>
 #include "GameObject.h"
 #include "Component.h"
 #include "Vector2.h"
+#include "Delegate.h"
+#include <coroutine>
+#include <memory>
 
 class Movement : public Component
 {
 public:
-  Movement(GameObject &associatedObject, float acceleration = 0.0f, float targetSpeed = 0.0f)
-      : Component(associatedObject), acceleration(acceleration), targetSpeed(targetSpeed) {}
+  // blockedByTiles: whether it stops at the solid tiles of the state's tile grid (going by it's object's collider)
+  Movement(GameObject &associatedObject, float acceleration = 0.0f, float targetSpeed = 0.0f, bool blockedByTiles = false)
+      : Component(associatedObject), acceleration(acceleration), targetSpeed(targetSpeed), blockedByTiles(blockedByTiles) {}
 
   virtual ~Movement() {}
 
   void Update(float deltaTime) override;
   RenderLayer GetRenderLayer() override { return RenderLayer::None; }
 
-  // Start moving towards this target
-  void MoveTo(Vector2 position, std::function<void()> callback = nullptr);
+  // Awaitable which resumes a behavior once the target is reached
+  // It resumes right away if another target replaced it or following was cancelled, whether before or while waiting
+  class Arrival
+  {
+  public:
+    Arrival(std::weak_ptr<Movement> movementWeak, int move) : movementWeak(movementWeak), move(move) {}
+
+    // Forgets the resume if the behavior is destroyed while waiting
+    ~Arrival();
+
+    Arrival(const Arrival &) = delete;
+    Arrival &operator=(const Arrival &) = delete;
+
+    bool await_ready() const;
+    void await_suspend(std::coroutine_handle<> coroutine);
+    void await_resume() { waiting = false; }
+
+  private:
+    std::weak_ptr<Movement> movementWeak;
+
+    // Which move it's waiting for
+    int move;
+
+    bool waiting{false};
+  };
+
+  // Start moving towards this target, resuming whoever awaited the previous one
+  Arrival MoveTo(Vector2 position, Delegate<void()> callback = nullptr);
 
   Vector2 GetDirection() { return targetDirection; }
 
+  // cancelFollow: stops following the target (resuming whoever awaited it)
   void Move(Vector2 direction, bool cancelFollow = true);
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+
+  // The target reach callback & the awaiting behavior aren't saved, so they're dropped
+  void LoadState(BinaryReader &reader) override;
+
 private:
   // Update speed to match target direction
   void Accelerate(float deltaTime);
@@ -46,10 +82,21 @@ private:
   // Speed to accelerate to when direction magnitude is 1
   float targetSpeed;
 
+  bool blockedByTiles;
+
   // Callback to execute on target reach
-  std::function<void()> targetReachCallback;
+  Delegate<void()> targetReachCallback;
+
+  // Behavior awaiting the current target
+  std::coroutine_handle<> waitingArrival;
+
+  // Counts calls to MoveTo, identifying the current target
+  int moveCount{0};
 
   void FollowTarget(float deltaTime);
+
+  // Resumes the behavior awaiting the current target, if any
+  void ResumeArrival();
 };
 
 #endif
\ No newline at end of file
@@ -28,6 +28,10 @@ public:
   void Update(float deltaTime) override;
   void OnBeforeDestroy() override;
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+
 private:
   void Accelerate(float deltaTime);
   void Rotate(float deltaTime);
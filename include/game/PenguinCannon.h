@@ -4,6 +4,7 @@
 #include "GameObject.h"
 #include "Component.h"
 #include <memory>
+#include <vector>
 
 class PenguinCannon : public Component
 {
@@ -20,6 +21,15 @@ public:
   // Cooldown
   static const float cooldown;
 
+  // How far around the mouse to look for an enemy to aim at
+  static const float aimAssistRadius;
+
+  // Most radians a shot is turned by to aim at an enemy
+  static const float aimAssistAngle;
+
+  // Identifier of the cooldown timer
+  static const TimerId cooldownTimer;
+
   PenguinCannon(GameObject &associatedObject) : Component(associatedObject) {}
 
   virtual ~PenguinCannon() {}
@@ -31,6 +41,13 @@ public:
 
   // Get gun point position
   Vector2 GunPointPosition();
+
+private:
+  // Rotation to shoot with: if the cannon's aim misses, it's turned a little towards the enemy nearest the mouse
+  float AssistedRotation();
+
+  // Buffer for enemy searches
+  std::vector<std::shared_ptr<GameObject>> nearbyEnemies;
 };
 
 #endif
\ No newline at end of file
@@ -21,6 +21,11 @@ public:
 
   void Update(float deltaTime) override;
 
+  void SaveConstruction(BinaryWriter &writer) override;
+  void SaveState(BinaryWriter &writer) override;
+  void LoadState(BinaryReader &reader) override;
+  void OnRestore() override;
+
 private:
   void Chase();
 
@@ -38,6 +43,9 @@ private:
 
   // Chase steering power, in radians
   float chaseSteering;
+
+  // Id of the target, kept while a snapshot is restored (-1 if none)
+  int targetId{-1};
 };
 
 #endif
\ No newline at end of file
@@ -14,9 +14,6 @@ public:
   void InitializeObjects() override;
 
   void Update(float deltaTime) override;
-
-private:
-  std::weak_ptr<GameObject> instructionWeak;
 };
 
 #endif
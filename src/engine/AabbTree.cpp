@@ -0,0 +1,290 @@
+#include <algorithm>
+#include "AabbTree.h"
+#include "Helper.h"
+
+using namespace std;
+
+const float AabbTree::defaultFatMargin{16};
+const int AabbTree::nullNode{-1};
+
+int AabbTree::AllocateNode()
+{
+  int index;
+
+  if (freeList == nullNode)
+  {
+    index = nodes.size();
+    nodes.emplace_back();
+  }
+  else
+  {
+    index = freeList;
+    freeList = nodes[index].parent;
+  }
+
+  Node &node = nodes[index];
+  node.parent = node.child1 = node.child2 = nullNode;
+  node.height = 0;
+
+  return index;
+}
+
+void AabbTree::FreeNode(int index)
+{
+  nodes[index].parent = freeList;
+  nodes[index].height = -1;
+  freeList = index;
+}
+
+int AabbTree::CreateProxy(const Bounds &bounds)
+{
+  int leaf = AllocateNode();
+
+  nodes[leaf].proxyBounds = bounds;
+  nodes[leaf].bounds = bounds.Expanded(fatMargin);
+
+  InsertLeaf(leaf);
+
+  return leaf;
+}
+
+void AabbTree::MoveProxy(int proxy, const Bounds &bounds)
+{
+  ASSERT(proxy >= 0 && proxy < (int)nodes.size() && nodes[proxy].height == 0, "Invalid AABB tree proxy ", proxy);
+
+  nodes[proxy].proxyBounds = bounds;
+
+  // Still within it's fat bounds: nothing to do
+  if (nodes[proxy].bounds.Contains(bounds))
+    return;
+
+  RemoveLeaf(proxy);
+  nodes[proxy].bounds = bounds.Expanded(fatMargin);
+  InsertLeaf(proxy);
+
+  reinsertCount++;
+}
+
+void AabbTree::DestroyProxy(int proxy)
+{
+  ASSERT(proxy >= 0 && proxy < (int)nodes.size() && nodes[proxy].height == 0, "Invalid AABB tree proxy ", proxy);
+
+  RemoveLeaf(proxy);
+  FreeNode(proxy);
+}
+
+void AabbTree::FindPairs(vector<pair<int, int>> &pairs)
+{
+  pairs.clear();
+
+  // Every pair of leaves splits at exactly one node, so testing the two subtrees of each node against each other finds each pair once
+  for (int index = 0; index < (int)nodes.size(); index++)
+  {
+    if (nodes[index].height <= 0)
+      continue;
+
+    nodeStack.clear();
+    nodeStack.emplace_back(nodes[index].child1, nodes[index].child2);
+
+    while (nodeStack.empty() == false)
+    {
+      auto [index1, index2] = nodeStack.back();
+      nodeStack.pop_back();
+
+      const Node &node1 = nodes[index1], &node2 = nodes[index2];
+
+      if (node1.bounds.Overlaps(node2.bounds) == false)
+        continue;
+
+      if (node1.IsLeaf() && node2.IsLeaf())
+      {
+        // Fat bounds only tell they may overlap
+        if (node1.proxyBounds.Overlaps(node2.proxyBounds))
+          pairs.push_back(minmax(index1, index2));
+      }
+
+      // Go down the larger one
+      else if (node2.IsLeaf() || (node1.IsLeaf() == false && node1.bounds.HalfPerimeter() >= node2.bounds.HalfPerimeter()))
+      {
+        nodeStack.emplace_back(node1.child1, index2);
+        nodeStack.emplace_back(node1.child2, index2);
+      }
+      else
+      {
+        nodeStack.emplace_back(index1, node2.child1);
+        nodeStack.emplace_back(index1, node2.child2);
+      }
+    }
+  }
+}
+
+void AabbTree::Query(const Bounds &bounds, vector<int> &proxies)
+{
+  Query(bounds, [this, &bounds, &proxies](int leaf)
+        {
+          // Fat bounds only tell it may overlap
+          if (nodes[leaf].proxyBounds.Overlaps(bounds))
+            proxies.push_back(leaf); });
+}
+
+void AabbTree::InsertLeaf(int leaf)
+{
+  if (root == nullNode)
+  {
+    root = leaf;
+    nodes[root].parent = nullNode;
+    return;
+  }
+
+  // Find the best sibling, going down the cheapest branch (cost is the perimeter of the bounds it creates or enlarges)
+  Bounds leafBounds = nodes[leaf].bounds;
+  int index = root;
+
+  while (nodes[index].IsLeaf() == false)
+  {
+    const Node &node = nodes[index];
+
+    float combinedCost = node.bounds.Union(leafBounds).HalfPerimeter();
+
+    // Cost of making a new parent for this node & the leaf
+    float cost = 2 * combinedCost;
+
+    // Cost every node below this one pays for enlarging it
+    float inheritedCost = 2 * (combinedCost - node.bounds.HalfPerimeter());
+
+    // Cost of going down into a child
+    auto ChildCost = [this, &leafBounds, inheritedCost](int child)
+    {
+      float enlarged = nodes[child].bounds.Union(leafBounds).HalfPerimeter();
+
+      return (nodes[child].IsLeaf() ? enlarged : enlarged - nodes[child].bounds.HalfPerimeter()) + inheritedCost;
+    };
+
+    float cost1 = ChildCost(node.child1);
+    float cost2 = ChildCost(node.child2);
+
+    if (cost < cost1 && cost < cost2)
+      break;
+
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  // Make a new parent for the sibling & the leaf
+  int sibling = index;
+  int oldParent = nodes[sibling].parent;
+  int newParent = AllocateNode();
+
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].bounds = leafBounds.Union(nodes[sibling].bounds);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].child1 = sibling;
+  nodes[newParent].child2 = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if (oldParent == nullNode)
+    root = newParent;
+  else if (nodes[oldParent].child1 == sibling)
+    nodes[oldParent].child1 = newParent;
+  else
+    nodes[oldParent].child2 = newParent;
+
+  Refit(nodes[leaf].parent);
+}
+
+void AabbTree::RemoveLeaf(int leaf)
+{
+  if (leaf == root)
+  {
+    root = nullNode;
+    return;
+  }
+
+  // Replace the leaf's parent with it's sibling
+  int parent = nodes[leaf].parent;
+  int grandParent = nodes[parent].parent;
+  int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+  nodes[sibling].parent = grandParent;
+  FreeNode(parent);
+
+  if (grandParent == nullNode)
+  {
+    root = sibling;
+    return;
+  }
+
+  if (nodes[grandParent].child1 == parent)
+    nodes[grandParent].child1 = sibling;
+  else
+    nodes[grandParent].child2 = sibling;
+
+  Refit(grandParent);
+}
+
+void AabbTree::Refit(int index)
+{
+  while (index != nullNode)
+  {
+    index = Balance(index);
+
+    Node &node = nodes[index];
+    node.height = 1 + max(nodes[node.child1].height, nodes[node.child2].height);
+    node.bounds = nodes[node.child1].bounds.Union(nodes[node.child2].bounds);
+
+    index = node.parent;
+  }
+}
+
+int AabbTree::Balance(int indexA)
+{
+  Node &a = nodes[indexA];
+
+  if (a.IsLeaf() || a.height < 2)
+    return indexA;
+
+  int indexB = a.child1, indexC = a.child2;
+  int balance = nodes[indexC].height - nodes[indexB].height;
+
+  if (balance >= -1 && balance <= 1)
+    return indexA;
+
+  // Rotate the taller child up, in a's place
+  // a keeps the shorter child, and takes the shorter grandchild of the taller one
+  bool rotateC = balance > 1;
+  int indexUp = rotateC ? indexC : indexB;
+  int indexKept = rotateC ? indexB : indexC;
+  Node &up = nodes[indexUp];
+
+  int indexF = up.child1, indexG = up.child2;
+
+  // Put up in a's place
+  up.child1 = indexA;
+  up.parent = a.parent;
+  a.parent = indexUp;
+
+  if (up.parent == nullNode)
+    root = indexUp;
+  else if (nodes[up.parent].child1 == indexA)
+    nodes[up.parent].child1 = indexUp;
+  else
+    nodes[up.parent].child2 = indexUp;
+
+  // Up keeps it's taller grandchild, a takes the other one
+  int indexTall = nodes[indexF].height > nodes[indexG].height ? indexF : indexG;
+  int indexShort = indexTall == indexF ? indexG : indexF;
+
+  up.child2 = indexTall;
+
+  a.child1 = indexKept;
+  a.child2 = indexShort;
+  nodes[indexShort].parent = indexA;
+
+  a.bounds = nodes[indexKept].bounds.Union(nodes[indexShort].bounds);
+  a.height = 1 + max(nodes[indexKept].height, nodes[indexShort].height);
+
+  up.bounds = a.bounds.Union(nodes[indexTall].bounds);
+  up.height = 1 + max(a.height, nodes[indexTall].height);
+
+  return indexUp;
+}
@@ -0,0 +1,180 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// How many phases there are
+static const int phaseCount{(int)FramePhase::Other + 1};
+
+// === STATE =======================================
+// Kept as constant initialized globals so that allocations made before main are safe to record
+
+// Phase to attribute allocations to
+static atomic<int> currentPhase{(int)FramePhase::Other};
+
+// Counters of the frame in progress
+static atomic<size_t> currentAllocations[phaseCount];
+static atomic<size_t> currentBytes[phaseCount];
+
+// Counters of the last closed frame
+static AllocationTracker::Counter lastFrame[phaseCount];
+
+// Frames closed since the last warmup reset
+static int framesSinceReset{0};
+
+// Steady state statistics (frames after warmup)
+static int steadyFrames{0};
+static size_t steadyAllocations[phaseCount];
+static size_t peakFrameAllocations{0};
+
+// Budget configuration
+static size_t frameBudget{numeric_limits<size_t>::max()};
+static int warmupFrames{30};
+static bool strictBudget{false};
+static int budgetViolations{0};
+
+// Phase names, for reports
+static const char *phaseNames[phaseCount]{"input", "update", "delete", "collisions", "events", "render", "other"};
+
+// === PUBLIC METHODS =================================
+
+bool AllocationTracker::Enabled()
+{
+#ifdef ALLOCATION_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AllocationTracker::Record(size_t bytes)
+{
+  int phase = currentPhase.load(memory_order_relaxed);
+
+  currentAllocations[phase].fetch_add(1, memory_order_relaxed);
+  currentBytes[phase].fetch_add(bytes, memory_order_relaxed);
+}
+
+void AllocationTracker::SetPhase(FramePhase phase) { currentPhase.store((int)phase, memory_order_relaxed); }
+
+void AllocationTracker::EndFrame()
+{
+  size_t frameAllocations{0};
+
+  // Close each phase's counters
+  for (int phase{0}; phase < phaseCount; phase++)
+  {
+    lastFrame[phase].allocations = currentAllocations[phase].exchange(0, memory_order_relaxed);
+    lastFrame[phase].bytes = currentBytes[phase].exchange(0, memory_order_relaxed);
+
+    frameAllocations += lastFrame[phase].allocations;
+  }
+
+  currentPhase.store((int)FramePhase::Other, memory_order_relaxed);
+
+  // Ignore frames still in warmup
+  if (Enabled() == false || ++framesSinceReset <= warmupFrames)
+    return;
+
+  // Collect steady state statistics
+  steadyFrames++;
+  peakFrameAllocations = max(peakFrameAllocations, frameAllocations);
+
+  for (int phase{0}; phase < phaseCount; phase++)
+    steadyAllocations[phase] += lastFrame[phase].allocations;
+
+  // Check budget
+  if (frameAllocations <= frameBudget)
+    return;
+
+  budgetViolations++;
+
+  // Only interrupt the game when strict, otherwise it's shown in the report
+  if (strictBudget)
+    throw runtime_error("Frame allocated " + to_string(frameAllocations) +
+                        " times, exceeding the budget of " + to_string(frameBudget));
+}
+
+void AllocationTracker::SetBudget(size_t maxAllocationsPerFrame, int warmup)
+{
+  frameBudget = maxAllocationsPerFrame;
+  warmupFrames = warmup;
+}
+
+void AllocationTracker::SetStrict(bool strict) { strictBudget = strict; }
+
+AllocationTracker::Counter AllocationTracker::GetLastFrame()
+{
+  Counter total;
+
+  for (int phase{0}; phase < phaseCount; phase++)
+  {
+    total.allocations += lastFrame[phase].allocations;
+    total.bytes += lastFrame[phase].bytes;
+  }
+
+  return total;
+}
+
+AllocationTracker::Counter AllocationTracker::GetLastFrame(FramePhase phase) { return lastFrame[(int)phase]; }
+
+int AllocationTracker::GetBudgetViolations() { return budgetViolations; }
+
+void AllocationTracker::ResetWarmup() { framesSinceReset = 0; }
+
+void AllocationTracker::Report()
+{
+  if (Enabled() == false)
+    return;
+
+  cout << "Allocation report: " << steadyFrames << " steady state frames, peak of "
+       << peakFrameAllocations << " allocations in a frame, "
+       << budgetViolations << " budget violations" << endl;
+
+  if (steadyFrames == 0)
+    return;
+
+  for (int phase{0}; phase < phaseCount; phase++)
+    cout << "  " << phaseNames[phase] << ": "
+         << (float)steadyAllocations[phase] / steadyFrames << " allocations per frame" << endl;
+}
+
+// === GLOBAL ALLOCATION FUNCTIONS =================================
+
+#ifdef ALLOCATION_TRACKING
+
+void *operator new(size_t size)
+{
+  AllocationTracker::Record(size);
+
+  if (void *pointer = malloc(size == 0 ? 1 : size))
+    return pointer;
+
+  throw bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+  AllocationTracker::Record(size);
+
+  return malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size, const nothrow_t &tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete[](void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { free(pointer); }
+void operator delete(void *pointer, const nothrow_t &) noexcept { free(pointer); }
+void operator delete[](void *pointer, const nothrow_t &) noexcept { free(pointer); }
+
+#endif
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include "BroadPhase.h"
+#include "SpatialHash.h"
+#include "AabbTree.h"
+#include "SweepAndPrune.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace Helper;
+
+void BroadPhase::Benchmark(int proxyCount, int frames)
+{
+  using Clock = chrono::steady_clock;
+
+  // How large the world is
+  const float worldSize = 4000;
+
+  // Mostly bullet sized proxies, some minion sized ones, and a few huge ones
+  vector<Bounds> bounds(proxyCount);
+  vector<Vector2> velocities(proxyCount);
+
+  for (int index = 0; index < proxyCount; index++)
+  {
+    int kind = RandomRange(0, 100);
+    float size = kind < 80 ? RandomRange(8.0f, 32.0f) : kind < 98 ? RandomRange(50.0f, 100.0f) : RandomRange(400.0f, 800.0f);
+    Vector2 corner(RandomRange(0.0f, worldSize), RandomRange(0.0f, worldSize));
+
+    bounds[index] = Bounds(corner, corner + Vector2(size, size));
+    velocities[index] = Vector2(RandomRange(-4.0f, 4.0f), RandomRange(-4.0f, 4.0f));
+  }
+
+  // Moves every proxy a little, for the given frame
+  auto Move = [&](int frame)
+  {
+    for (int index = 0; index < proxyCount; index++)
+    {
+      // Turn around every so often, so that they stay in place overall
+      Vector2 step = (frame / 30) % 2 == 0 ? velocities[index] : -velocities[index];
+      bounds[index] = Bounds(bounds[index].min + step, bounds[index].max + step);
+    }
+  };
+
+  vector<pair<int, int>> pairs;
+  size_t allPairsFound = 0;
+
+  // Baseline: test every pair
+  vector<Bounds> initialBounds = bounds;
+  auto start = Clock::now();
+
+  for (int frame = 0; frame < frames; frame++)
+  {
+    Move(frame);
+    pairs.clear();
+
+    for (int first = 0; first < proxyCount; first++)
+      for (int second = first + 1; second < proxyCount; second++)
+        if (bounds[first].Overlaps(bounds[second]))
+          pairs.emplace_back(first, second);
+
+    allPairsFound += pairs.size();
+  }
+
+  double allPairsTime = chrono::duration<double, milli>(Clock::now() - start).count() / frames;
+
+  cout << "Broad phase benchmark: " << proxyCount << " proxies over " << frames << " frames, "
+       << (float)allPairsFound / frames << " overlapping pairs per frame" << endl
+       << "  all pairs: " << allPairsTime << "ms per frame" << endl;
+
+  // Times a broad phase over the same motion, checking that it finds the same pairs
+  auto Time = [&](const char *name, unique_ptr<BroadPhase> broadPhase)
+  {
+    bounds = initialBounds;
+
+    vector<int> proxies(proxyCount);
+    size_t found = 0;
+    auto start = Clock::now();
+
+    for (int index = 0; index < proxyCount; index++)
+      proxies[index] = broadPhase->CreateProxy(bounds[index]);
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+      Move(frame);
+
+      for (int index = 0; index < proxyCount; index++)
+        broadPhase->MoveProxy(proxies[index], bounds[index]);
+
+      broadPhase->FindPairs(pairs);
+      found += pairs.size();
+    }
+
+    double time = chrono::duration<double, milli>(Clock::now() - start).count() / frames;
+
+    cout << "  " << name << ": " << time << "ms per frame" << (found == allPairsFound ? "" : " (FOUND DIFFERENT PAIRS)") << endl;
+
+    return broadPhase;
+  };
+
+  Time("spatial hash", make_unique<SpatialHash>());
+
+  auto tree = Time("AABB tree", make_unique<AabbTree>());
+  auto &aabbTree = static_cast<AabbTree &>(*tree);
+
+  cout << "  AABB tree height " << aabbTree.GetHeight() << ", " << (float)aabbTree.GetReinsertCount() / frames << " reinserts per frame" << endl;
+
+  auto sweep = Time("sweep and prune", make_unique<SweepAndPrune>());
+  auto &sweepAndPrune = static_cast<SweepAndPrune &>(*sweep);
+
+  cout << "  sweep and prune: " << sweepAndPrune.GetSwapCount() << " swaps, " << sweepAndPrune.GetAddedPairs().size() << " added & "
+       << sweepAndPrune.GetRemovedPairs().size() << " removed pairs on the last frame" << endl;
+}
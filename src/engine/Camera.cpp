@@ -93,7 +93,7 @@ void Camera::Move(Vector2 speedModification, float deltaTime)
 Vector2 GetInputSpeedChange()
 {
   // Get input reference
-  auto inputManager = InputManager::GetInstance();
+  auto &inputManager = InputManager::GetInstance();
 
   // Will hold camera displacement values
   Vector2 frameSpeedChange{Vector2::Zero()};
@@ -0,0 +1,11 @@
+#include "CameraFollower.h"
+#include "ComponentRegistry.h"
+
+static shared_ptr<Component> RebuildCameraFollower(GameObject &object, BinaryReader &reader)
+{
+  return object.AddComponent<CameraFollower>(reader.Read<bool>());
+}
+
+REGISTER_COMPONENT(CameraFollower, RebuildCameraFollower)
+
+void CameraFollower::SaveConstruction(BinaryWriter &writer) { writer.Write(useRawPosition); }
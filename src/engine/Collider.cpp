@@ -1,41 +1,76 @@
 #include "Collider.h"
 #include "Game.h"
 #include "Camera.h"
+#include "ComponentRegistry.h"
+#include "ShapeCollision.h"
 #include <memory>
 
 using namespace std;
 
+static shared_ptr<Component> RebuildCollider(GameObject &object, BinaryReader &reader)
+{
+  Rectangle box = reader.ReadRectangle();
+  auto collider = object.AddComponent<Collider>(box, reader.Read<ColliderShape>());
+  collider->layer = reader.Read<CollisionLayer>();
+  collider->continuous = reader.Read<bool>();
+  collider->bodyType = reader.Read<BodyType>();
+
+  return collider;
+}
+
+REGISTER_COMPONENT(Collider, RebuildCollider)
+
 // Explicitly initialize box
-Collider::Collider(GameObject &associatedObject, Rectangle box) : Component(associatedObject)
+Collider::Collider(GameObject &associatedObject, Rectangle box, ColliderShape shape) : Component(associatedObject), box(box)
 {
-  SetBox(box);
+  SetShape(shape);
 }
 
 // Use sprite's box
-Collider::Collider(GameObject &associatedObject, shared_ptr<Sprite> sprite, Vector2 scale)
+Collider::Collider(GameObject &associatedObject, shared_ptr<Sprite> sprite, Vector2 scale, ColliderShape shape)
     : Collider(associatedObject,
-               Rectangle(0, 0, sprite->GetWidth() * scale.x, sprite->GetHeight() * scale.y)) {}
+               Rectangle(0, 0, sprite->GetWidth() * scale.x, sprite->GetHeight() * scale.y), shape) {}
 
 // Use sprite's box
-Collider::Collider(GameObject &associatedObject, shared_ptr<SpriteAnimator> animator, Vector2 scale)
+Collider::Collider(GameObject &associatedObject, shared_ptr<SpriteAnimator> animator, Vector2 scale, ColliderShape shape)
     : Collider(associatedObject,
-               Rectangle(0, 0, animator->GetFrameWidth() * scale.x, animator->GetFrameHeight() * scale.y)) {}
+               Rectangle(0, 0, animator->GetFrameWidth() * scale.x, animator->GetFrameHeight() * scale.y), shape) {}
+
+Collider::~Collider() { gameState.UnregisterCollider(*this); }
 
 void Collider::SetBox(const Rectangle &newBox)
 {
   box = newBox;
 
-  maxVertexDistance = sqrt(box.width * box.width + box.height * box.height) / 2;
+  boundingRadius = ShapeCollision::BoundingRadiusOf(shape, box.width, box.height);
+}
+
+void Collider::SetShape(ColliderShape newShape)
+{
+  shape = newShape;
+
+  boundingRadius = ShapeCollision::BoundingRadiusOf(shape, box.width, box.height);
 }
 
 Rectangle Collider::GetBox() const { return box + gameObject.GetPosition(); }
 
+void Collider::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(box);
+  writer.Write(shape);
+  writer.Write(layer);
+  writer.Write(continuous);
+  writer.Write(bodyType);
+}
+
 void Collider::Start()
 {
   // Announce to game state
-  gameState.RegisterCollider(dynamic_pointer_cast<Collider>(GetShared()));
+  gameState.RegisterCollider(*this);
 }
 
+void Collider::OnBeforeDestroy() { gameState.UnregisterCollider(*this); }
+
 void Collider::Render()
 {
   // auto box = GetBox();
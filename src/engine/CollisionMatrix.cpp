@@ -0,0 +1,33 @@
+#include "CollisionMatrix.h"
+
+using namespace std;
+
+static const char *layerNames[(int)CollisionLayer::Count]{"Default", "Player", "Enemies", "PlayerProjectiles", "EnemyProjectiles"};
+
+CollisionMatrix::CollisionMatrix()
+{
+  for (auto &mask : masks)
+    mask = (1u << (int)CollisionLayer::Count) - 1;
+}
+
+void CollisionMatrix::SetInteraction(CollisionLayer layer1, CollisionLayer layer2, bool interacts)
+{
+  if (interacts)
+  {
+    masks[(int)layer1] |= 1u << (int)layer2;
+    masks[(int)layer2] |= 1u << (int)layer1;
+  }
+  else
+  {
+    masks[(int)layer1] &= ~(1u << (int)layer2);
+    masks[(int)layer2] &= ~(1u << (int)layer1);
+  }
+}
+
+void CollisionMatrix::Clear()
+{
+  for (auto &mask : masks)
+    mask = 0;
+}
+
+const char *CollisionMatrix::GetName(CollisionLayer layer) { return layerNames[(int)layer]; }
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <iostream>
+#include "CollisionStats.h"
+#include "CollisionMatrix.h"
+
+using namespace std;
+
+bool CollisionStats::reporting{false};
+
+void CollisionStats::Counter::Add(const Counter &other)
+{
+  colliders += other.colliders;
+  staticColliders += other.staticColliders;
+  sleepingColliders += other.sleepingColliders;
+  allPairs += other.allPairs;
+  candidatePairs += other.candidatePairs;
+  culledPairs += other.culledPairs;
+  staticPairs += other.staticPairs;
+  restingPairs += other.restingPairs;
+  wokenColliders += other.wokenColliders;
+  circleRejections += other.circleRejections;
+  boxRejections += other.boxRejections;
+  sweptTests += other.sweptTests;
+  shapeTests += other.shapeTests;
+  narrowTests += other.narrowTests;
+  hits += other.hits;
+  enteredContacts += other.enteredContacts;
+  exitedContacts += other.exitedContacts;
+
+  for (int layer1 = 0; layer1 < (int)CollisionLayer::Count; layer1++)
+    for (int layer2 = layer1; layer2 < (int)CollisionLayer::Count; layer2++)
+    {
+      keptLayerPairs[layer1][layer2] += other.keptLayerPairs[layer1][layer2];
+      culledLayerPairs[layer1][layer2] += other.culledLayerPairs[layer1][layer2];
+    }
+}
+
+void CollisionStats::Counter::CountLayerPair(CollisionLayer layer1, CollisionLayer layer2, bool culled)
+{
+  int lowest = min((int)layer1, (int)layer2), highest = max((int)layer1, (int)layer2);
+
+  if (culled)
+  {
+    culledPairs++;
+    culledLayerPairs[lowest][highest]++;
+  }
+  else
+    keptLayerPairs[lowest][highest]++;
+}
+
+void CollisionStats::SetReporting(bool reporting) { CollisionStats::reporting = reporting; }
+
+void CollisionStats::EndFrame()
+{
+  total.Add(frame);
+  lastFrame = frame;
+  frame = Counter{};
+  frames++;
+}
+
+void CollisionStats::Report() const
+{
+  if (reporting == false || frames == 0 || total.colliders == 0)
+    return;
+
+  auto PerFrame = [this](size_t value)
+  { return (float)value / frames; };
+
+  cout << "Collision report: " << frames << " frames" << endl
+       << "  colliders: " << PerFrame(total.colliders) << " per frame" << endl
+       << "  static colliders: " << PerFrame(total.staticColliders) << " per frame" << endl
+       << "  sleeping colliders: " << PerFrame(total.sleepingColliders) << " per frame ("
+       << 100.0f * total.sleepingColliders / total.colliders << "% of colliders)" << endl
+       << "  colliders woken: " << PerFrame(total.wokenColliders) << " per frame" << endl
+       << "  all pairs: " << PerFrame(total.allPairs) << " per frame" << endl
+       << "  candidate pairs: " << PerFrame(total.candidatePairs) << " per frame" << endl
+       << "  culled by layers: " << PerFrame(total.culledPairs) << " per frame" << endl
+       << "  skipped as static: " << PerFrame(total.staticPairs) << " per frame" << endl
+       << "  skipped as resting: " << PerFrame(total.restingPairs) << " per frame" << endl
+       << "  rejected by circles: " << PerFrame(total.circleRejections) << " per frame" << endl
+       << "  rejected by boxes: " << PerFrame(total.boxRejections) << " per frame" << endl
+       << "  swept tests: " << PerFrame(total.sweptTests) << " per frame" << endl
+       << "  round shape tests: " << PerFrame(total.shapeTests) << " per frame" << endl
+       << "  SAT tests: " << PerFrame(total.narrowTests) << " per frame" << endl
+       << "  hits: " << PerFrame(total.hits) << " per frame" << endl
+       << "  contacts entered: " << PerFrame(total.enteredContacts) << " per frame" << endl
+       << "  contacts exited: " << PerFrame(total.exitedContacts) << " per frame" << endl
+       << "  candidate pairs by layers:" << endl;
+
+  for (int layer1 = 0; layer1 < (int)CollisionLayer::Count; layer1++)
+    for (int layer2 = layer1; layer2 < (int)CollisionLayer::Count; layer2++)
+    {
+      size_t kept = total.keptLayerPairs[layer1][layer2], culled = total.culledLayerPairs[layer1][layer2];
+
+      if (kept + culled == 0)
+        continue;
+
+      cout << "    " << CollisionMatrix::GetName((CollisionLayer)layer1) << " & " << CollisionMatrix::GetName((CollisionLayer)layer2)
+           << ": " << PerFrame(kept) << " kept, " << PerFrame(culled) << " culled per frame" << endl;
+    }
+}
@@ -5,7 +5,9 @@
 using namespace std;
 
 Component::Component(GameObject &associatedObject)
-    : gameObject(associatedObject), gameState(gameObject.gameState), inputManager(InputManager::GetInstance()) {}
+    : gameObject(associatedObject), gameState(gameObject.gameState), inputManager(InputManager::GetInstance()),
+      // Spread lowered rate updates of objects created together over different frames
+      waitedFrames(associatedObject.id % (int)UpdateRate::Eighth) {}
 
 void Component::StartAndRegisterLayer()
 {
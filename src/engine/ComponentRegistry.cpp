@@ -0,0 +1,55 @@
+#include "ComponentRegistry.h"
+#include "Component.h"
+
+using namespace std;
+
+vector<ComponentRegistry::Entry> &ComponentRegistry::GetEntries()
+{
+  static vector<Entry> entries;
+  return entries;
+}
+
+unordered_map<type_index, int> &ComponentRegistry::GetIds()
+{
+  static unordered_map<type_index, int> ids;
+  return ids;
+}
+
+int ComponentRegistry::Register(const type_info &type, const string &name, ComponentFactory factory)
+{
+  auto [entry, inserted] = GetIds().try_emplace(type_index(type), (int)GetEntries().size());
+
+  ASSERT(inserted, "Component type ", name, " was registered twice");
+
+  GetEntries().push_back(Entry{name, factory});
+
+  return entry->second;
+}
+
+int ComponentRegistry::GetId(const Component &component)
+{
+  auto &ids = GetIds();
+  auto entry = ids.find(type_index(typeid(component)));
+
+  return entry == ids.end() ? -1 : entry->second;
+}
+
+int ComponentRegistry::GetId(const string &name)
+{
+  auto &entries = GetEntries();
+
+  for (int id = 0; id < (int)entries.size(); id++)
+    if (entries[id].name == name)
+      return id;
+
+  return -1;
+}
+
+shared_ptr<Component> ComponentRegistry::Create(int id, GameObject &object, BinaryReader &reader)
+{
+  ASSERT(id >= 0 && id < (int)GetEntries().size(), "Tried to rebuild a component whose type isn't registered");
+
+  return GetEntries()[id].factory(object, reader);
+}
+
+const string &ComponentRegistry::GetName(int id) { return GetEntries()[id].name; }
@@ -10,6 +10,9 @@ void Debug::DrawPoint(Vector2 point, bool convertToScreen)
     point = Camera::GetInstance().WorldToScreen(point);
   }
 
+  // Draw it over the sprites queued so far
+  Game::GetInstance().GetSpriteBatch().Flush();
+
   auto renderer = Game::GetInstance().GetRenderer();
 
   SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
@@ -0,0 +1,172 @@
+#include "Event.h"
+#include <algorithm>
+
+using namespace std;
+
+EventStats Event::frameStats;
+EventStats Event::lastFrameStats;
+
+// === EVENT QUEUE =================================
+
+EventQueue::EventQueue()
+{
+  queued.reserve(32);
+  dispatching.reserve(32);
+}
+
+void EventQueue::Dispatch()
+{
+  // Listeners may queue more calls, so keep going until it's empty
+  while (queued.empty() == false)
+  {
+    swap(queued, dispatching);
+
+    // Calls of destroyed events carry their own callback
+    for (auto &call : dispatching)
+      if (call.event != nullptr)
+        call.event->CallDeferred(call.listener);
+      else if (call.callback)
+        call.callback();
+
+    dispatching.clear();
+  }
+}
+
+void EventQueue::Detach(Event &event)
+{
+  // The calls being dispatched may not have happened yet either
+  for (auto calls : {&queued, &dispatching})
+    for (auto &call : *calls)
+      if (call.event == &event)
+      {
+        // Only listeners still subscribed are called
+        if (auto listener = event.FindListener(call.listener))
+          call.callback = listener->callback;
+
+        call.event = nullptr;
+      }
+}
+
+// === EVENT =================================
+
+Event::~Event()
+{
+  if (queue != nullptr)
+    queue->Detach(*this);
+}
+
+ListenerHandle Event::AddListener(functionType callback)
+{
+  ListenerHandle handle = nextHandle++;
+
+  (invokeDepth > 0 ? pendingListeners : listeners).push_back(Listener{handle, move(callback)});
+
+  return handle;
+}
+
+void Event::RemoveListener(ListenerHandle handle)
+{
+  auto HasHandle = [handle](const Listener &listener)
+  { return listener.handle == handle; };
+
+  // Simply erase it if it's not subscribed yet
+  pendingListeners.erase(remove_if(pendingListeners.begin(), pendingListeners.end(), HasHandle), pendingListeners.end());
+
+  auto listenerIterator = find_if(listeners.begin(), listeners.end(), HasHandle);
+
+  if (listenerIterator == listeners.end() || !listenerIterator->callback)
+    return;
+
+  // Callbacks can't be erased while running, so empty it for now
+  if (invokeDepth > 0)
+  {
+    listenerIterator->callback = nullptr;
+    removedWhileInvoking++;
+    return;
+  }
+
+  listeners.erase(listenerIterator);
+}
+
+void Event::Invoke()
+{
+  frameStats.invoked++;
+  frameStats.listenersCalled += listeners.size();
+
+  // Defer to queue
+  if (queue != nullptr)
+  {
+    frameStats.deferred++;
+
+    for (auto &listener : listeners)
+      if (listener.callback)
+        queue->Push(*this, listener.handle);
+
+    return;
+  }
+
+  invokeDepth++;
+
+  // Removed listeners are only emptied, and new ones are held apart, so the list is stable while iterating
+  for (auto &listener : listeners)
+    if (listener.callback)
+      listener.callback();
+
+  // Apply changes made by the listeners once the outermost invocation is done
+  if (--invokeDepth == 0)
+    SettleListeners();
+}
+
+auto Event::FindListener(ListenerHandle handle) -> Listener *
+{
+  auto listener = find_if(listeners.begin(), listeners.end(), [handle](const Listener &listener)
+                          { return listener.handle == handle; });
+
+  // Removed listeners are only emptied while invoking
+  if (listener == listeners.end() || !listener->callback)
+    return nullptr;
+
+  return &*listener;
+}
+
+void Event::CallDeferred(ListenerHandle handle)
+{
+  auto listener = FindListener(handle);
+
+  // It may have been removed since it was queued
+  if (listener == nullptr)
+    return;
+
+  // The listener may subscribe or remove listeners, so hold those changes as when invoking
+  invokeDepth++;
+
+  listener->callback();
+
+  if (--invokeDepth == 0)
+    SettleListeners();
+}
+
+void Event::SettleListeners()
+{
+  if (removedWhileInvoking > 0)
+  {
+    listeners.erase(
+        remove_if(listeners.begin(), listeners.end(), [](const Listener &listener)
+                  { return !listener.callback; }),
+        listeners.end());
+
+    removedWhileInvoking = 0;
+  }
+
+  for (auto &listener : pendingListeners)
+    listeners.push_back(move(listener));
+
+  pendingListeners.clear();
+}
+
+void Event::EndFrame()
+{
+  lastFrameStats = frameStats;
+
+  frameStats = EventStats();
+}
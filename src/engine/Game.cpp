@@ -10,6 +10,9 @@
 #include "Resources.h"
 #include "InputManager.h"
 #include "TitleState.h"
+#include "MainState.h"
+#include "GameData.h"
+#include "AllocationTracker.h"
 
 using namespace std;
 using namespace Helper;
@@ -23,18 +26,33 @@ const int Game::screenWidth{1024};
 // Defines the resolution height
 const int Game::screenHeight{600};
 
+// Defines how many heap allocations a steady state frame may perform (the peak of the headless run)
+const int Game::frameAllocationBudget{80};
+
+// Seeds the random generator of headless runs
+const int Game::headlessSeed{1};
+
+bool Game::headless{false};
+
 // === EXTERNAL METHODS =================================
 
 // Initializes SDL
-auto InitializeSDL(string title, int width, int height) -> pair<SDL_Window *, SDL_Renderer *>
+auto InitializeSDL(string title, int width, int height, bool headless) -> pair<SDL_Window *, SDL_Renderer *>
 {
   // === BASE SDL
 
+  // Without a screen or speakers, use the drivers which output nothing
+  if (headless)
+  {
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+  }
+
   // Initialize SDL & all it's necessary subsystems
   auto encounteredError = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER);
 
   // Catch any errors
-  Assert(!encounteredError, "Failed to initialize SDL");
+  CHECK(!encounteredError, "Failed to initialize SDL. Reported error: ", SDL_GetError());
 
   // === SDL IMAGE
 
@@ -43,7 +61,7 @@ auto InitializeSDL(string title, int width, int height) -> pair<SDL_Window *, SD
   int returnedFlags = IMG_Init(requestedFlags);
 
   // Check if everything went alright
-  Assert((returnedFlags & requestedFlags) == requestedFlags, "Failed to initialize SDL-image", IMG_GetError());
+  CHECK((returnedFlags & requestedFlags) == requestedFlags, "Failed to initialize SDL-image. Reported error: ", IMG_GetError());
 
   // === SDL MIXER
 
@@ -55,7 +73,7 @@ auto InitializeSDL(string title, int width, int height) -> pair<SDL_Window *, SD
       MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 1024);
 
   // Catch any errors
-  Assert(!encounteredError, "Failed to initialize SDL-mixer", Mix_GetError());
+  CHECK(!encounteredError, "Failed to initialize SDL-mixer. Reported error: ", Mix_GetError());
 
   // Allocate more sound channels
   Mix_AllocateChannels(32);
@@ -63,7 +81,7 @@ auto InitializeSDL(string title, int width, int height) -> pair<SDL_Window *, SD
   // === SDL FONTS
 
   // Ensure initializing works
-  Assert(TTF_Init() == 0, "Failed to initialize SDL-ttf", TTF_GetError());
+  CHECK(TTF_Init() == 0, "Failed to initialize SDL-ttf. Reported error: ", TTF_GetError());
 
   // === GAME WINDOW
 
@@ -71,13 +89,13 @@ auto InitializeSDL(string title, int width, int height) -> pair<SDL_Window *, SD
       title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, 0);
 
   // Catch any errors
-  Assert(gameWindow != nullptr, "Failed to create SDL window");
+  CHECK(gameWindow != nullptr, "Failed to create SDL window. Reported error: ", SDL_GetError());
 
-  // Create renderer
-  auto renderer = SDL_CreateRenderer(gameWindow, -1, SDL_RENDERER_ACCELERATED);
+  // Create renderer (the dummy video driver only has the software one)
+  auto renderer = SDL_CreateRenderer(gameWindow, -1, headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
 
   // Catch any errors
-  Assert(renderer != nullptr, "Failed to create SDL renderer");
+  CHECK(renderer != nullptr, "Failed to create SDL renderer. Reported error: ", SDL_GetError());
 
   return make_pair(gameWindow, renderer);
 }
@@ -118,7 +136,7 @@ Game::Game(string title, int width, int height)
   // === INIT SDL
 
   // Retrieve the window & the renderer from the initializer
-  auto pointers = InitializeSDL(title, width, height);
+  auto pointers = InitializeSDL(title, width, height, headless);
 
   // === INITIALIZE STATE
 
@@ -127,7 +145,12 @@ Game::Game(string title, int width, int height)
 
   // === INIT RANDOMNESS
 
-  srand(time(NULL));
+  // Headless runs are seeded the same every time, so that they play out the same
+  Random::Seed(headless ? headlessSeed : time(NULL));
+
+  // === ALLOCATION BUDGET
+
+  AllocationTracker::SetBudget(frameAllocationBudget);
 }
 
 Game::~Game()
@@ -139,6 +162,13 @@ Game::~Game()
 
 void Game::CalculateDeltaTime()
 {
+  // Headless runs take fixed steps, so that they don't depend on how fast the machine is
+  if (headless)
+  {
+    deltaTime = 1.0f / frameRate;
+    return;
+  }
+
   // Get this frame's start time
   float newFrameStart = SDL_GetTicks();
 
@@ -212,26 +242,39 @@ void Game::Start()
     CalculateDeltaTime();
 
     // Get input
+    AllocationTracker::SetPhase(FramePhase::Input);
     inputManager.Update();
 
-    // Update the state's timer
-    state.timer.Update(deltaTime);
+    // Fire the state's due timed callbacks
+    AllocationTracker::SetPhase(FramePhase::Update);
+    state.timingWheel.Advance(deltaTime);
     
     // Update the state
     state.Update(deltaTime);
 
     // Render the state
+    AllocationTracker::SetPhase(FramePhase::Render);
     state.Render();
 
     // WARNING: DO NOT USE state FROM HERE UNTIL END OF LOOP
 
-    // Render the window
+    // Submit the last batch of sprites & render the window
+    spriteBatch.EndFrame();
     SDL_RenderPresent(GetRenderer());
 
-    // Delay the frame to obey the framerate
-    SDL_Delay(frameDelay);
+    // Close this frame's counters
+    AllocationTracker::EndFrame();
+    Event::EndFrame();
+
+    // Delay the frame to obey the framerate (headless runs go as fast as they can)
+    if (headless == false)
+      SDL_Delay(frameDelay);
   }
 
+  // Show allocation statistics
+  AllocationTracker::Report();
+  spriteBatch.Report();
+
   // Make sure state pile is empty
   while (loadedStates.size() > 0)
     loadedStates.pop();
@@ -242,7 +285,7 @@ void Game::Start()
 
 GameState &Game::GetState() const
 {
-  Assert(loadedStates.size() > 0, "No game state loaded");
+  ASSERT(loadedStates.size() > 0, "No game state loaded");
 
   return *loadedStates.top();
 }
@@ -251,7 +294,7 @@ void Game::PushState(std::unique_ptr<GameState> &&state)
 {
   // Alert if next is overridden
   if (nextState != nullptr)
-    cout << "WARNING: call to " << __FUNCTION__ << " will override previous call in the same frame" << endl;
+    WARN("call to ", __FUNCTION__, " will override previous call in the same frame");
 
   // Store this state for next frame
   nextState = move(state);
@@ -259,7 +302,7 @@ void Game::PushState(std::unique_ptr<GameState> &&state)
 
 void Game::PushNextState()
 {
-  Assert(nextState != nullptr, "Failed to push next state: it was nullptr");
+  ASSERT(nextState != nullptr, "Failed to push next state: it was nullptr");
 
   // Put current state on hold
   if (loadedStates.size() > 0)
@@ -268,6 +311,9 @@ void Game::PushNextState()
   // Move this state to the stack
   loadedStates.emplace(move(nextState));
 
+  // Loading a state is expected to allocate, so don't hold it against the budget
+  AllocationTracker::ResetWarmup();
+
   // Start it if necessary
   if (started)
     GetState().Start();
@@ -282,7 +328,7 @@ void Game::PopState()
   if (loadedStates.size() == 0)
   {
     // Throws if there is no nextState
-    Assert(nextState != nullptr, "Game was left without any loaded states");
+    ASSERT(nextState != nullptr, "Game was left without any loaded states");
 
     return;
   }
@@ -293,5 +339,9 @@ void Game::PopState()
 
 unique_ptr<GameState> Game::GetInitialState() const
 {
+  // Skip the title when benchmarking
+  if (GameData::GetInstance().benchmarkScene)
+    return make_unique<MainState>();
+
   return make_unique<TitleState>();
 }
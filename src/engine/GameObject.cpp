@@ -7,7 +7,9 @@
 using namespace std;
 
 // Private constructor
-GameObject::GameObject(string name, GameState &gameState) : gameState(gameState), id(gameState.SupplyObjectId()), name(name)
+GameObject::GameObject(string name, GameState &gameState) : GameObject(name, gameState, gameState.SupplyObjectId()) {}
+
+GameObject::GameObject(string name, GameState &gameState, int id) : gameState(gameState), timer(gameState.timingWheel), id(id), name(name)
 {
 }
 
@@ -30,6 +32,13 @@ GameObject::GameObject(string name, Vector2 coordinates, double rotation, shared
 
     // Give parent a reference to self
     parent->children[id] = weak_ptr(shared);
+
+    // Sleep along with the parent
+    asleep = parent->asleep;
+
+    // Only top level objects are placed in regions
+    if (parent->IsRoot())
+      gameState.regionGrid.Track(shared);
   }
 
   SetPosition(coordinates);
@@ -53,19 +62,54 @@ void GameObject::Start()
 
 void GameObject::Update(float deltaTime)
 {
-  // Update timers
-  timer.Update(deltaTime);
-
-  if (enabled == false)
+  if (IsEnabled() == false)
     return;
 
+  // Update interval for this object's position (only found if some component allows lowering it's rate)
+  int objectInterval = 0;
+
   for (const auto &component : components)
   {
-    if (component->IsEnabled())
-      component->Update(deltaTime);
+    if (component->IsEnabled() == false)
+      continue;
+
+    int interval = (int)component->GetMinUpdateRate();
+
+    if (interval > 1)
+    {
+      if (objectInterval == 0)
+        objectInterval = gameState.updateScheduler.GetInterval(GetPosition());
+
+      interval = min(interval, objectInterval);
+    }
+
+    component->pendingDeltaTime += deltaTime;
+    component->waitedFrames++;
+
+    if (gameState.updateScheduler.ShouldUpdate(interval, component->waitedFrames) == false)
+      continue;
+
+    float componentDeltaTime = component->pendingDeltaTime;
+
+    component->pendingDeltaTime = 0.0f;
+    component->waitedFrames = 0;
+
+    component->Update(componentDeltaTime);
   }
 }
 
+void GameObject::SetAsleep(bool asleep)
+{
+  if (this->asleep == asleep)
+    return;
+
+  this->asleep = asleep;
+
+  for (auto &[childId, childWeak] : children)
+    if (auto child = childWeak.lock())
+      child->SetAsleep(asleep);
+}
+
 void GameObject::OnStatePause()
 {
   for (auto component : components)
@@ -114,18 +158,36 @@ auto GameObject::GetComponent(const Component *componentPointer) const -> shared
   return *componentIterator;
 }
 
+int GameObject::GetComponentIndex(const Component *componentPointer) const
+{
+  for (int index = 0; index < (int)components.size(); index++)
+    if (components[index].get() == componentPointer)
+      return index;
+
+  return -1;
+}
+
+auto GameObject::GetComponentAt(int index) const -> shared_ptr<Component>
+{
+  ASSERT(index >= 0 && index < (int)components.size(), "Component index out of range");
+
+  return components[index];
+}
+
 shared_ptr<GameObject> GameObject::InternalGetParent() const
 {
   // Ensure not root
-  Assert(IsRoot() == false, "Getting parent is forbidden on root object");
+  ASSERT(IsRoot() == false, "Getting parent is forbidden on root object");
 
   if (IsRoot())
     return nullptr;
 
+  auto parent = weakParent.lock();
+
   // Ensure the parent is there
-  Assert(weakParent.expired() == false, "GameObject " + name + " unexpectedly failed to retrieve parent object");
+  ASSERT(parent != nullptr, "GameObject ", name, " unexpectedly failed to retrieve parent object");
 
-  return weakParent.lock();
+  return parent;
 }
 
 shared_ptr<GameObject> GameObject::GetParent() const
@@ -146,7 +208,7 @@ void GameObject::UnlinkParent()
 
 void GameObject::SetParent(shared_ptr<GameObject> newParent)
 {
-  Assert(IsRoot() == false, "SetParent is forbidden on root object");
+  ASSERT(IsRoot() == false, "SetParent is forbidden on root object");
 
   // Delete current parent
   UnlinkParent();
@@ -233,13 +295,9 @@ void GameObject::InternalDestroy()
   // Get pointer to self
   auto shared = GetShared();
 
-  // Remove all children
-  for (auto pairIterator = children.begin(); pairIterator != children.end(); ++pairIterator)
-  {
-    LOCK(pairIterator->second, child);
-
+  // Remove all children (iterate over a copy, as each child erases itself from the children map)
+  for (auto &child : GetChildren())
     child->InternalDestroy();
-  }
 
   // Remove this object's reference from it's parent
   UnlinkParent();
@@ -248,12 +306,24 @@ void GameObject::InternalDestroy()
   gameState.RemoveObject(id);
 
   // Ensure no more references to self than the one in this function and the one which called this function
-  Assert(shared.use_count() == 2, "Found leaked references to game object " + GetName() + " when trying to destroy it");
+  ASSERT(shared.use_count() == 2, "Found leaked references to game object ", GetName(), " when trying to destroy it");
 }
 
-void GameObject::OnCollision(GameObject &other)
+void GameObject::OnCollisionEnter(GameObject &other)
 {
   // Alert all components
-  for (auto component : components)
-    component->OnCollision(other);
+  for (auto &component : components)
+    component->OnCollisionEnter(other);
+}
+
+void GameObject::OnCollisionStay(GameObject &other)
+{
+  for (auto &component : components)
+    component->OnCollisionStay(other);
+}
+
+void GameObject::OnCollisionExit(GameObject &other)
+{
+  for (auto &component : components)
+    component->OnCollisionExit(other);
 }
\ No newline at end of file
@@ -8,39 +8,39 @@
 #include "Camera.h"
 #include "Resources.h"
 #include "SatCollision.h"
+#include "ShapeCollision.h"
+#include "WorkerPool.h"
+#include "SpatialHash.h"
+#include "AllocationTracker.h"
 #include <iostream>
 
-#define CASCADE_OBJECTS(method, param) CascadeDown(rootObject, [param](GameObject &object) { object.method(param); });
+#define CASCADE_OBJECTS(method, param) CascadeDown(*rootObject, [param](GameObject &object) { object.method(param); });
 
 using namespace std;
 
-// Whether the two collider lists have some pair of colliders which are colliding
-bool CheckForCollision(vector<shared_ptr<Collider>> colliders1, vector<shared_ptr<Collider>> colliders2)
-{
-  for (auto collider1 : colliders1)
-  {
-    for (auto collider2 : colliders2)
-    {
-      if (SatCollision::IsColliding(
-              collider1->GetBox(), collider2->GetBox(),
-              collider1->gameObject.GetRotation(), collider2->gameObject.GetRotation(),
-              pow(collider1->GetMaxVertexDistance() + collider2->GetMaxVertexDistance(), 2)))
-      {
-        return true;
-      }
-    }
-  }
+const int GameState::parallelNarrowPairs{256};
 
-  return false;
-}
+const int GameState::sleepFrames{30};
 
-// Initialize root object
-GameState::GameState() : inputManager(InputManager::GetInstance()), rootObject(new GameObject("Root", *this))
+const float GameState::raycastPieceLength{256};
+
+const float GameState::nearestSearchRadius{128};
+
+// Initialize root object (with an explicit id, as the id counter is only initialized after it)
+GameState::GameState()
+    : timer(timingWheel), inputManager(InputManager::GetInstance()), rootObject(new GameObject("Root", *this, 0)),
+      broadPhase(make_unique<SpatialHash>())
 {
 }
 
 GameState::~GameState()
 {
+  collisionStats.Report();
+
+  // Let go of the objects while the registries their components leave are still around
+  rootObject->children.clear();
+  gameObjects.clear();
+
   // Clear unused resources
   Resources::ClearAll();
 
@@ -48,19 +48,19 @@ GameState::~GameState()
   Camera::GetInstance().Reset();
 }
 
-void GameState::CascadeDown(shared_ptr<GameObject> object, function<void(GameObject &)> callback, bool topDown)
+void GameState::CascadeDown(GameObject &object, const Delegate<void(GameObject &)> &callback, bool topDown)
 {
   // Execute on this object
   if (topDown)
-    callback(*object);
+    callback(object);
 
   // Update it's children
-  for (auto child : object->GetChildren())
-    CascadeDown(child, callback, topDown);
+  for (auto &child : object.GetChildren())
+    CascadeDown(*child, callback, topDown);
 
   // Execute on this object (bottom up case)
   if (topDown == false)
-    callback(*object);
+    callback(object);
 }
 
 void GameState::DeleteObjects()
@@ -87,31 +87,257 @@ void GameState::DeleteObjects()
 
 void GameState::DetectCollisions()
 {
-  // Get validated colliders
-  auto validatedColliderStructure = ValidateColliders();
+  GatherColliders();
+
+  // Broad phase
+  broadPhase->FindPairs(candidatePairs);
+
+  auto &stats = collisionStats.GetFrame();
+  stats.colliders = awakeColliderCount;
+  stats.allPairs = (size_t)awakeColliderCount * (awakeColliderCount - 1) / 2;
+  stats.candidatePairs = candidatePairs.size();
+
+  // Keep the pairs that need a narrow phase test
+  narrowPairs.clear();
+  hits.clear();
+
+  for (auto [proxy1, proxy2] : candidatePairs)
+  {
+    int index1 = colliderOfProxy[proxy1], index2 = colliderOfProxy[proxy2];
+    auto &entry1 = colliders[index1];
+    auto &entry2 = colliders[index2];
+
+    // Layers that don't interact are dropped before any narrow phase work
+    bool interacts = collisionMatrix.Interacts(entry1.layer, entry2.layer);
+    stats.CountLayerPair(entry1.layer, entry2.layer, interacts == false);
+
+    if (interacts == false)
+      continue;
+
+    // Colliders of the same object don't collide
+    if (entry1.object == entry2.object)
+      continue;
+
+    if (entry1.bodyType == BodyType::Static && entry2.bodyType == BodyType::Static)
+    {
+      stats.staticPairs++;
+      continue;
+    }
+
+    // Neither moved, so whatever contact their objects had goes on
+    if (entry1.IsResting() && entry2.IsResting())
+    {
+      stats.restingPairs++;
+
+      Hit hit = Hit::Between(entry1.object, entry2.object, 1);
+
+      if (binary_search(contacts.begin(), contacts.end(), hit.objects))
+        hits.push_back(hit);
+
+      continue;
+    }
+
+    // Something moving touches them: wake them up
+    for (auto entry : {&entry1, &entry2})
+      if (entry->IsSleeping())
+      {
+        entry->stillFrames = 0;
+        stats.wokenColliders++;
+      }
+
+    narrowPairs.emplace_back(index1, index2);
+  }
+
+  // Group the pairs by their first collider, so that it can be tested against all of it's seconds at once
+  if (is_sorted(narrowPairs.begin(), narrowPairs.end()) == false)
+    sort(narrowPairs.begin(), narrowPairs.end());
+
+  // Split them among workers when there are enough to make up for waking them
+  WorkerPool &workerPool = WorkerPool::GetInstance();
+  int workerCount = (int)narrowPairs.size() >= parallelNarrowPairs ? workerPool.GetWorkerCount() : 1;
+
+  narrowOutputs.resize(max((int)narrowOutputs.size(), workerCount));
+
+  for (int worker = 0; worker < workerCount; worker++)
+    narrowOutputs[worker].Clear();
+
+  auto RunShare = [this, workerCount](int worker)
+  { TestNarrowPairs(narrowPairs.size() * worker / workerCount, narrowPairs.size() * (worker + 1) / workerCount, narrowOutputs[worker]); };
+
+  if (workerCount > 1)
+    workerPool.Run(RunShare);
+  else
+    RunShare(0);
+
+  // Gather what they found (in the order of the pairs, so that it's the same however they were split)
+
+  for (int worker = 0; worker < workerCount; worker++)
+  {
+    auto &output = narrowOutputs[worker];
+
+    hits.insert(hits.end(), output.hits.begin(), output.hits.end());
+    stats.sweptTests += output.sweptTests;
+    stats.circleRejections += output.circleRejections;
+    stats.shapeTests += output.shapeTests;
+    stats.boxRejections += output.boxRejections;
+    stats.narrowTests += output.satTests;
+  }
+
+  // Objects collide once, however many of their colliders touch, at the earliest time any of them does
+  sort(hits.begin(), hits.end(), [](const Hit &hit1, const Hit &hit2)
+       { return hit1.objects != hit2.objects ? hit1.objects < hit2.objects : hit1.time < hit2.time; });
+  hits.erase(unique(hits.begin(), hits.end(), [](const Hit &hit1, const Hit &hit2)
+                    { return hit1.objects == hit2.objects; }),
+             hits.end());
+
+  stats.hits = hits.size();
+
+  newContacts.clear();
+
+  for (auto &hit : hits)
+    newContacts.push_back(hit.objects);
+
+  // Inform them in the order they touched (discrete hits last, as they're only seen at the end of the frame)
+  sort(hits.begin(), hits.end(), [](const Hit &hit1, const Hit &hit2)
+       { return hit1.time != hit2.time ? hit1.time < hit2.time : hit1.objects < hit2.objects; });
+
+  // Objects are only removed between detections, so those found are all still around
+  for (auto &hit : hits)
+  {
+    auto &object1 = *hit.object1;
+    auto &object2 = *hit.object2;
+
+    // What an earlier hit destroyed doesn't go on to hit what was behind it
+    if (object1.DestroyRequested() || object2.DestroyRequested())
+      continue;
+
+    if (binary_search(contacts.begin(), contacts.end(), hit.objects))
+    {
+      object1.OnCollisionStay(object2);
+      object2.OnCollisionStay(object1);
+    }
+    else
+    {
+      stats.enteredContacts++;
+      object1.OnCollisionEnter(object2);
+      object2.OnCollisionEnter(object1);
+    }
+  }
+
+  // End the contacts that weren't found again
+  size_t foundContacts = newContacts.size();
+
+  for (auto [objectId1, objectId2] : contacts)
+  {
+    if (binary_search(newContacts.begin(), newContacts.begin() + foundContacts, make_pair(objectId1, objectId2)))
+      continue;
+
+    auto objectIterator1 = gameObjects.find(objectId1), objectIterator2 = gameObjects.find(objectId2);
+
+    if (objectIterator1 == gameObjects.end() || objectIterator2 == gameObjects.end())
+      continue;
+
+    // Asleep objects only left the broad phase, so their contacts go on until they wake up and are tested again
+    if (objectIterator1->second->IsAsleep() || objectIterator2->second->IsAsleep())
+    {
+      newContacts.emplace_back(objectId1, objectId2);
+      continue;
+    }
+
+    stats.exitedContacts++;
+    objectIterator1->second->OnCollisionExit(*objectIterator2->second);
+    objectIterator2->second->OnCollisionExit(*objectIterator1->second);
+  }
+
+  // Keep them sorted, for the searches above
+  if (newContacts.size() > foundContacts)
+    sort(newContacts.begin(), newContacts.end());
+
+  swap(contacts, newContacts);
+
+  collisionStats.EndFrame();
+}
+
+void GameState::NarrowOutput::Clear()
+{
+  hits.clear();
+  sweptTests = circleRejections = shapeTests = boxRejections = satTests = 0;
+}
 
-  // For each object
-  auto objectEntryIterator = validatedColliderStructure.begin();
-  while (objectEntryIterator != validatedColliderStructure.end())
+void GameState::TestNarrowPairs(size_t start, size_t end, NarrowOutput &output)
+{
+  for (size_t groupStart = start, groupEnd = start; groupStart < end; groupStart = groupEnd)
   {
-    // Test, for each OTHER object in the list (excluding the ones before this one)
-    decltype(objectEntryIterator) otherObjectEntryIterator{objectEntryIterator};
-    otherObjectEntryIterator++;
-    while (otherObjectEntryIterator != validatedColliderStructure.end())
+    auto &entry1 = colliders[narrowPairs[groupStart].first];
+
+    output.batch.Clear();
+    output.batchSeconds.clear();
+
+    for (groupEnd = groupStart; groupEnd < end && narrowPairs[groupEnd].first == narrowPairs[groupStart].first; groupEnd++)
     {
-      // Check if they are colliding
-      if (CheckForCollision(objectEntryIterator->second, otherObjectEntryIterator->second))
+      auto &entry2 = colliders[narrowPairs[groupEnd].second];
+
+      // Continuous colliders are swept from where they were (the tests below only see where they ended up)
+      if (entry1.motion || entry2.motion)
+      {
+        output.sweptTests++;
+
+        OrientedBox start1 = entry1.box, start2 = entry2.box;
+        start1.center = start1.center - entry1.motion;
+        start2.center = start2.center - entry2.motion;
+
+        float time = ShapeCollision::FindTimeOfImpact(entry1.shape, start1, entry1.motion, entry2.shape, start2, entry2.motion);
+
+        if (time >= 0)
+          output.hits.push_back(Hit::Between(entry1.object, entry2.object, time));
+
+        continue;
+      }
+
+      // Bounding circles too far apart
+      if (SatCollision::AreCirclesTouching(entry1.box.center, entry1.radius, entry2.box.center, entry2.radius) == false)
+      {
+        output.circleRejections++;
+        continue;
+      }
+
+      // Round shapes have their own exact tests
+      if (entry1.shape != ColliderShape::Box || entry2.shape != ColliderShape::Box)
+      {
+        output.shapeTests++;
+
+        if (ShapeCollision::IsColliding(entry1.shape, entry1.box, entry2.shape, entry2.box))
+          output.hits.push_back(Hit::Between(entry1.object, entry2.object, 1));
+
+        continue;
+      }
+
+      // Two unrotated boxes are settled by their bounds alone
+      if (entry1.axisAligned && entry2.axisAligned)
       {
-        auto &object1 = *gameObjects[objectEntryIterator->first];
-        auto &object2 = *gameObjects[otherObjectEntryIterator->first];
-        object1.OnCollision(object2);
-        object2.OnCollision(object1);
+        if (SatCollision::AreAlignedBoxesColliding(entry1.box, entry2.box))
+          output.hits.push_back(Hit::Between(entry1.object, entry2.object, 1));
+        else
+          output.boxRejections++;
+
+        continue;
       }
 
-      otherObjectEntryIterator++;
+      // The rest go through SAT together
+      output.batch.Add(entry2.box);
+      output.batchSeconds.push_back(entry2.object);
     }
 
-    objectEntryIterator++;
+    if (output.batchSeconds.empty())
+      continue;
+
+    output.satTests += output.batchSeconds.size();
+    output.results.resize(output.batchSeconds.size());
+    SatCollision::CollideMany(entry1.box, output.batch, output.results.data());
+
+    for (size_t index = 0; index < output.batchSeconds.size(); index++)
+      if (output.results[index])
+        output.hits.push_back(Hit::Between(entry1.object, output.batchSeconds[index], 1));
   }
 }
 
@@ -126,14 +352,31 @@ void GameState::Update(float deltaTime)
   // Update camera
   Camera::GetInstance().Update(deltaTime);
 
+  Vector2 viewSize(Game::screenWidth, Game::screenHeight);
+
+  // Put objects to sleep or wake them up
+  regionGrid.Update(Camera::GetInstance().GetRawPosition() + viewSize / 2);
+
+  // Base this frame's update rates on the camera view
+  updateScheduler.BeginFrame(Camera::GetInstance().GetRawPosition(), viewSize);
+
   // Update game objects
   CASCADE_OBJECTS(Update, deltaTime);
 
   // Delete dead ones
+  AllocationTracker::SetPhase(FramePhase::Delete);
   DeleteObjects();
 
   // Inform them of any collisions
+  AllocationTracker::SetPhase(FramePhase::Collisions);
   DetectCollisions();
+
+  // Dispatch this frame's deferred events in one batch
+  AllocationTracker::SetPhase(FramePhase::Events);
+  eventQueue.Dispatch();
+
+  // Anything the derived state does after this is still update logic
+  AllocationTracker::SetPhase(FramePhase::Update);
 }
 
 void GameState::Render()
@@ -235,69 +478,313 @@ void GameState::RegisterLayerRenderer(shared_ptr<Component> component)
   // Get it's layer
   auto &layer = layerStructure[component->GetRenderLayer()];
 
-  // Add it's entry
-  layer.emplace_back(component);
+  // Drop erased ones, which pile up when objects are removed without rendering in between (e.g. restoring snapshots)
+  erase_if(layer, [](const weak_ptr<Component> &other)
+           { return other.expired(); });
+
+  // Insert it after the ones which render before or along with it, keeping the layer sorted
+  int renderOrder = component->GetRenderOrder();
 
-  // Sort it
-  sort(layer.begin(), layer.end(), [](weak_ptr<Component> comp1Weak, weak_ptr<Component> comp2Weak)
-       { 
-        auto comp1 = comp1Weak.lock();
-        auto comp2 = comp2Weak.lock();
+  auto position = upper_bound(layer.begin(), layer.end(), renderOrder, [](int renderOrder, const weak_ptr<Component> &other)
+                              { return renderOrder < other.lock()->GetRenderOrder(); });
 
-        // Leave as is if any of them has been erased
-        if (comp1 == nullptr || comp2 == nullptr) return true;
-        
-        return comp1->GetRenderOrder() < comp2->GetRenderOrder(); });
+  layer.insert(position, component);
 }
 
-void GameState::RegisterCollider(shared_ptr<Collider> collider)
+void GameState::RegisterCollider(Collider &collider)
 {
-  if (!collider)
+  if (collider.registryIndex >= 0)
     return;
 
-  colliderStructure[collider->gameObject.id].emplace_back(collider);
+  collider.registryIndex = colliders.size();
+
+  ColliderEntry entry{};
+  entry.collider = &collider;
+  entry.object = &collider.gameObject;
+  entry.proxy = -1;
+
+  colliders.push_back(entry);
 }
 
-unordered_map<int, vector<shared_ptr<Collider>>> GameState::ValidateColliders()
+void GameState::UnregisterCollider(Collider &collider)
 {
-  unordered_map<int, vector<shared_ptr<Collider>>> verifiedCollidersStructure;
+  int index = collider.registryIndex;
 
-  // For each object entry
-  auto objectEntryIterator = colliderStructure.begin();
-  while (objectEntryIterator != colliderStructure.end())
+  if (index < 0)
+    return;
+
+  if (colliders[index].proxy >= 0)
+    DestroyProxy(colliders[index]);
+
+  // Move the last one into it's place
+  if (index != (int)colliders.size() - 1)
   {
-    auto &objectColliders = objectEntryIterator->second;
+    colliders[index] = colliders.back();
+    colliders[index].collider->registryIndex = index;
 
-    // For each of it's colliders
-    auto colliderIterator = objectColliders.begin();
-    while (colliderIterator != objectColliders.end())
+    if (colliders[index].proxy >= 0)
+      colliderOfProxy[colliders[index].proxy] = index;
+  }
+
+  colliders.pop_back();
+  collider.registryIndex = -1;
+}
+
+void GameState::DestroyProxy(ColliderEntry &entry)
+{
+  broadPhase->DestroyProxy(entry.proxy);
+  colliderOfProxy[entry.proxy] = -1;
+  entry.proxy = -1;
+}
+
+// Whether the boxes are exactly the same (still objects keep their exact position)
+static bool IsSameBox(const OrientedBox &box1, const OrientedBox &box2)
+{
+  return box1.center.x == box2.center.x && box1.center.y == box2.center.y && box1.cosine == box2.cosine && box1.sine == box2.sine &&
+         box1.halfWidth == box2.halfWidth && box1.halfHeight == box2.halfHeight;
+}
+
+void GameState::GatherColliders()
+{
+  awakeColliderCount = 0;
+  colliderBounds = Bounds();
+
+  auto &stats = collisionStats.GetFrame();
+
+  for (int index = 0; index < (int)colliders.size(); index++)
+  {
+    auto &entry = colliders[index];
+
+    // Asleep objects' colliders leave the broad phase until they wake up
+    if (entry.object->IsAsleep())
     {
-      // Remove it if it's expired
-      if (colliderIterator->expired())
+      if (entry.proxy >= 0)
+        DestroyProxy(entry);
+
+      continue;
+    }
+
+    Collider &collider = *entry.collider;
+    entry.bodyType = collider.bodyType;
+
+    // Static colliders stay where they were placed
+    if (entry.bodyType != BodyType::Static || entry.proxy < 0)
+    {
+      OrientedBox box(collider.GetBox(), entry.object->GetRotation());
+      ColliderShape shape = collider.GetShape();
+      bool still = entry.proxy >= 0 && shape == entry.shape && IsSameBox(box, entry.box);
+
+      entry.stillFrames = still ? entry.stillFrames + 1 : 0;
+      entry.layer = collider.layer;
+      entry.motion = Vector2();
+
+      // Still since the previous detection too, so it's proxy is already right (a continuous one's no longer covers any motion)
+      if (still && entry.stillFrames != 1)
       {
-        colliderIterator = objectColliders.erase(colliderIterator);
+        colliderBounds = awakeColliderCount == 0 ? entry.bounds : colliderBounds.Union(entry.bounds);
+        awakeColliderCount++;
+        stats.sleepingColliders += entry.IsSleeping();
         continue;
       }
 
-      // Otherwise lock it and add it
-      verifiedCollidersStructure[objectEntryIterator->first]
-          .push_back(colliderIterator->lock());
+      Bounds bounds = ShapeCollision::BoundsOf(shape, box);
+
+      // Continuous colliders cover all of the way from their last position
+      if (collider.continuous && entry.proxy >= 0)
+      {
+        entry.motion = box.center - entry.box.center;
+        bounds = bounds.Union(Bounds(bounds.min - entry.motion, bounds.max - entry.motion));
+      }
+
+      entry.box = box;
+      entry.shape = shape;
+      entry.radius = collider.GetBoundingRadius();
+      entry.axisAligned = shape == ColliderShape::Box && box.IsAxisAligned();
+      entry.bounds = bounds;
+
+      if (entry.proxy < 0)
+      {
+        entry.proxy = broadPhase->CreateProxy(bounds);
+
+        if (entry.proxy >= (int)colliderOfProxy.size())
+          colliderOfProxy.resize(entry.proxy + 1, -1);
 
-      // Advance
-      colliderIterator++;
+        colliderOfProxy[entry.proxy] = index;
+      }
+      else
+        broadPhase->MoveProxy(entry.proxy, bounds);
     }
 
-    // If it's empty, remove it from the map
-    if (objectColliders.empty())
-    {
-      objectEntryIterator = colliderStructure.erase(objectEntryIterator);
+    stats.staticColliders += entry.bodyType == BodyType::Static;
+    colliderBounds = awakeColliderCount == 0 ? entry.bounds : colliderBounds.Union(entry.bounds);
+    awakeColliderCount++;
+  }
+}
+
+void GameState::SetBroadPhase(unique_ptr<BroadPhase> newBroadPhase)
+{
+  ASSERT(newBroadPhase != nullptr, "Tried to set a null broad phase");
+
+  broadPhase = move(newBroadPhase);
+
+  // Colliders get new proxies on the next detection
+  for (auto &entry : colliders)
+    entry.proxy = -1;
+
+  colliderOfProxy.clear();
+}
+
+void GameState::QueryShape(ColliderShape shape, const OrientedBox &box, vector<shared_ptr<GameObject>> &objects, uint32_t layerMask)
+{
+  queryProxies.clear();
+  queryObjectIds.clear();
+
+  broadPhase->Query(ShapeCollision::BoundsOf(shape, box), queryProxies);
+
+  for (int proxy : queryProxies)
+  {
+    int index = colliderOfProxy[proxy];
+
+    if (index < 0)
       continue;
+
+    auto &entry = colliders[index];
+
+    if ((layerMask & (1u << (int)entry.layer)) && ShapeCollision::IsColliding(shape, box, entry.shape, entry.box))
+      queryObjectIds.push_back(entry.object->id);
+  }
+
+  AppendQueriedObjects(objects);
+}
+
+void GameState::AppendQueriedObjects(vector<shared_ptr<GameObject>> &objects)
+{
+  // Objects with several colliders may have been found more than once
+  sort(queryObjectIds.begin(), queryObjectIds.end());
+  queryObjectIds.erase(unique(queryObjectIds.begin(), queryObjectIds.end()), queryObjectIds.end());
+
+  for (int objectId : queryObjectIds)
+  {
+    auto objectIterator = gameObjects.find(objectId);
+
+    if (objectIterator != gameObjects.end() && objectIterator->second->DestroyRequested() == false)
+      objects.push_back(objectIterator->second);
+  }
+}
+
+void GameState::QueryBox(const Rectangle &box, float rotation, vector<shared_ptr<GameObject>> &objects, uint32_t layerMask)
+{
+  QueryShape(ColliderShape::Box, OrientedBox(box, rotation), objects, layerMask);
+}
+
+void GameState::QueryCircle(Vector2 center, float radius, vector<shared_ptr<GameObject>> &objects, uint32_t layerMask)
+{
+  QueryShape(ColliderShape::Circle, OrientedBox(Rectangle(center.x, center.y, radius * 2, radius * 2), 0), objects, layerMask);
+}
+
+bool GameState::Raycast(Vector2 origin, Vector2 direction, float maxDistance, RaycastHit &hit, uint32_t layerMask)
+{
+  direction = direction.Normalized();
+
+  float bestDistance = -1;
+  GameObject *bestObject = nullptr;
+
+  // Query the ray a piece at a time, so that long rays stop at the first piece with a hit instead of gathering everything along them
+  // (any collider entered before the end of a piece overlaps that piece or an earlier one)
+  for (float pieceStart = 0; pieceStart < maxDistance; pieceStart += raycastPieceLength)
+  {
+    float pieceEnd = min(pieceStart + raycastPieceLength, maxDistance);
+    Vector2 start = origin + direction * pieceStart, end = origin + direction * pieceEnd;
+
+    queryProxies.clear();
+    broadPhase->Query(Bounds(Vector2(min(start.x, end.x), min(start.y, end.y)), Vector2(max(start.x, end.x), max(start.y, end.y))),
+                      queryProxies);
+
+    for (int proxy : queryProxies)
+    {
+      int index = colliderOfProxy[proxy];
+
+      if (index < 0)
+        continue;
+
+      auto &entry = colliders[index];
+
+      if ((layerMask & (1u << (int)entry.layer)) == 0 || entry.object->DestroyRequested())
+        continue;
+
+      float distance = ShapeCollision::Raycast(entry.shape, entry.box, origin, direction, maxDistance);
+
+      if (distance < 0 || (bestDistance >= 0 && distance >= bestDistance))
+        continue;
+
+      bestDistance = distance;
+      bestObject = entry.object;
+    }
+
+    if (bestDistance >= 0 && bestDistance <= pieceEnd)
+      break;
+  }
+
+  if (bestDistance < 0)
+    return false;
+
+  hit = RaycastHit{bestObject->GetShared(), origin + direction * bestDistance, bestDistance};
+
+  return true;
+}
+
+void GameState::FindNearest(Vector2 position, Tag tag, int count, vector<shared_ptr<GameObject>> &objects, float maxDistance)
+{
+  // A point, to measure distances to colliders with
+  OrientedBox point(Rectangle(position.x, position.y, 0, 0), 0);
+
+  // Search ever larger squares until enough objects are within their inner circle, or they cover every collider
+  for (float radius = min(nearestSearchRadius, maxDistance);; radius = min(radius * 2, maxDistance))
+  {
+    Bounds searchBounds(position - Vector2(radius, radius), position + Vector2(radius, radius));
+    bool lastSearch = radius >= maxDistance || searchBounds.Contains(colliderBounds);
+
+    queryProxies.clear();
+    nearestCandidates.clear();
+
+    broadPhase->Query(searchBounds, queryProxies);
+
+    for (int proxy : queryProxies)
+    {
+      int index = colliderOfProxy[proxy];
+
+      if (index < 0)
+        continue;
+
+      auto &entry = colliders[index];
+
+      if (entry.object->tag != tag || entry.object->DestroyRequested())
+        continue;
+
+      float distance = max(ShapeCollision::FindDistance(ColliderShape::Circle, point, entry.shape, entry.box), 0.0f);
+
+      // Only those within the circle are surely nearer than any collider outside the square,
+      // but the last search has every collider that can be found, so it's corners count too
+      if (distance <= (lastSearch ? maxDistance : radius))
+        nearestCandidates.emplace_back(entry.object->id, distance);
     }
 
-    objectEntryIterator++;
+    // Keep each object's nearest collider
+    sort(nearestCandidates.begin(), nearestCandidates.end());
+    nearestCandidates.erase(unique(nearestCandidates.begin(), nearestCandidates.end(), [](const pair<int, float> &candidate1, const pair<int, float> &candidate2)
+                                   { return candidate1.first == candidate2.first; }),
+                            nearestCandidates.end());
+
+    if ((int)nearestCandidates.size() >= count || lastSearch)
+      break;
   }
 
-  return verifiedCollidersStructure;
+  // Nearest first
+  sort(nearestCandidates.begin(), nearestCandidates.end(), [](const pair<int, float> &candidate1, const pair<int, float> &candidate2)
+       { return candidate1.second != candidate2.second ? candidate1.second < candidate2.second : candidate1.first < candidate2.first; });
+
+  for (int index = 0; index < min(count, (int)nearestCandidates.size()); index++)
+    objects.push_back(gameObjects[nearestCandidates[index].first]);
 }
 
 shared_ptr<GameObject> GameState::GetObject(int id)
@@ -10,8 +10,9 @@ void InputManager::Update()
 {
   SDL_Event event;
 
-  // Get mouse coords
-  SDL_GetMouseState(&mouseX, &mouseY);
+  // Get mouse coords (a script moves the mouse by itself)
+  if (script.IsLoaded() == false)
+    SDL_GetMouseState(&mouseX, &mouseY);
 
   // Reset quit request
   quitRequested = false;
@@ -21,51 +22,65 @@ void InputManager::Update()
 
   // If there are any input events in the SDL stack pile, this function returns 1 and sets the argument to next event
   while (SDL_PollEvent(&event))
-  {
-    // Quit on quit event
-    if (event.type == SDL_QUIT)
-      quitRequested = true;
+    HandleEvent(event);
 
-    // On click event
-    else if (event.type == SDL_MOUSEBUTTONDOWN)
-    {
-      auto button = event.button.button;
+  // Play the script's events up to this frame
+  while (script.PollEvent(updateCounter, event))
+    HandleEvent(event);
+}
 
-      mouseState[button] = true;
-      mouseUpdate[button] = updateCounter;
-    }
+void InputManager::HandleEvent(const SDL_Event &event)
+{
+  // Quit on quit event
+  if (event.type == SDL_QUIT)
+    quitRequested = true;
 
-    // On un-click event
-    else if (event.type == SDL_MOUSEBUTTONUP)
-    {
-      auto button = event.button.button;
+  // On click event
+  else if (event.type == SDL_MOUSEBUTTONDOWN)
+  {
+    auto button = event.button.button;
 
-      mouseState[button] = false;
-      mouseUpdate[button] = updateCounter;
-    }
+    mouseState[button] = true;
+    mouseUpdate[button] = updateCounter;
+  }
 
-    // On keyboard event
-    else if (event.type == SDL_KEYDOWN)
-    {
-      // Ignore repetitions
-      if (!event.key.repeat)
-      {
-        auto symbol = event.key.keysym.sym;
-
-        keyState[symbol] = true;
-        keyUpdate[symbol] = updateCounter;
-      }
-    }
+  // On un-click event
+  else if (event.type == SDL_MOUSEBUTTONUP)
+  {
+    auto button = event.button.button;
+
+    mouseState[button] = false;
+    mouseUpdate[button] = updateCounter;
+  }
+
+  // On scripted mouse movement (the devices' is read from the mouse state instead)
+  else if (event.type == SDL_MOUSEMOTION && script.IsLoaded())
+  {
+    mouseX = event.motion.x;
+    mouseY = event.motion.y;
+  }
 
-    // On keyboard event
-    else if (event.type == SDL_KEYUP)
+  // On keyboard event
+  else if (event.type == SDL_KEYDOWN)
+  {
+    // Ignore repetitions
+    if (!event.key.repeat)
     {
       auto symbol = event.key.keysym.sym;
 
-      keyState[symbol] = false;
+      keyState[symbol] = true;
       keyUpdate[symbol] = updateCounter;
     }
   }
+
+  // On keyboard event
+  else if (event.type == SDL_KEYUP)
+  {
+    auto symbol = event.key.keysym.sym;
+
+    keyState[symbol] = false;
+    keyUpdate[symbol] = updateCounter;
+  }
 }
 
 Vector2 InputManager::GetMouseWorldCoordinates() const
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "InputScript.h"
+#include "Diagnostics.h"
+
+using namespace std;
+
+// Reads a mouse button name
+static Uint8 ReadButton(const string &name, const string &path, int lineNumber)
+{
+  if (name == "left")
+    return SDL_BUTTON_LEFT;
+
+  CHECK(name == "right", "Unknown mouse button ", name, " in input script ", path, ", line ", lineNumber);
+
+  return SDL_BUTTON_RIGHT;
+}
+
+void InputScript::Load(const string &path)
+{
+  ifstream file(path);
+
+  CHECK(file.is_open(), "Unable to open input script ", path);
+
+  actions.clear();
+  nextAction = 0;
+
+  string line;
+
+  for (int lineNumber = 1; getline(file, line); lineNumber++)
+  {
+    istringstream stream(line);
+    Action action{};
+    string type;
+
+    // Skip empty lines & comments
+    stream >> ws;
+
+    if (stream.eof() || stream.peek() == '#')
+      continue;
+
+    CHECK(stream >> action.frame >> type, "Missing frame or action in input script ", path, ", line ", lineNumber);
+
+    if (type == "press" || type == "release")
+    {
+      string key;
+      stream >> key;
+
+      action.event.type = type == "press" ? SDL_KEYDOWN : SDL_KEYUP;
+      action.event.key.keysym.sym = SDL_GetKeyFromName(key.c_str());
+
+      CHECK(action.event.key.keysym.sym != SDLK_UNKNOWN, "Unknown key ", key, " in input script ", path, ", line ", lineNumber);
+    }
+
+    else if (type == "click" || type == "unclick")
+    {
+      string button;
+      stream >> button;
+
+      action.event.type = type == "click" ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+      action.event.button.button = ReadButton(button, path, lineNumber);
+    }
+
+    else if (type == "mouse")
+    {
+      action.event.type = SDL_MOUSEMOTION;
+
+      CHECK(stream >> action.event.motion.x >> action.event.motion.y,
+            "Missing mouse coordinates in input script ", path, ", line ", lineNumber);
+    }
+
+    else
+    {
+      CHECK(type == "quit", "Unknown action ", type, " in input script ", path, ", line ", lineNumber);
+
+      action.event.type = SDL_QUIT;
+    }
+
+    actions.push_back(action);
+  }
+
+  // Keep the file's order among actions of the same frame
+  stable_sort(actions.begin(), actions.end(), [](const Action &action1, const Action &action2)
+              { return action1.frame < action2.frame; });
+
+  loaded = true;
+}
+
+bool InputScript::PollEvent(int frame, SDL_Event &event)
+{
+  if (nextAction == actions.size() || actions[nextAction].frame > frame)
+    return false;
+
+  event = actions[nextAction++].event;
+
+  return true;
+}
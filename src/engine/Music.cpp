@@ -8,7 +8,7 @@ using namespace std;
 
 void Music::Play(const int times)
 {
-  Assert(musicPath.size() > 0, "Tried playing music without providing it's file path");
+  ASSERT(musicPath.size() > 0, "Tried playing music without providing it's file path");
 
   // Get music
   music = Resources::GetMusic(musicPath);
@@ -16,7 +16,7 @@ void Music::Play(const int times)
   auto encounteredError = Mix_PlayMusic(music.get(), times);
 
   // Catch weird errors
-  Assert(!encounteredError, "Failed to play a music track");
+  CHECK(!encounteredError, "Failed to play a music track. Reported error: ", Mix_GetError());
 }
 
 Music::~Music()
@@ -0,0 +1,20 @@
+#include "Random.h"
+
+using namespace std;
+
+uint64_t Random::state{0x9E3779B97F4A7C15ull};
+
+void Random::Seed(uint64_t seed)
+{
+  // Zero is the one state xorshift can't leave
+  state = seed != 0 ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+uint32_t Random::Next()
+{
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+
+  return (state * 0x2545F4914F6CDD1Dull) >> 32;
+}
@@ -21,10 +21,10 @@ void Recipes::PenguinBody(shared_ptr<GameObject> penguin)
   auto sprite = penguin->AddComponent<Sprite>("./assets/image/penguin.png", RenderLayer::Player);
 
   // Get collider
-  penguin->AddComponent<Collider>(sprite);
+  penguin->AddComponent<Collider>(sprite)->layer = CollisionLayer::Player;
 
-  // Add movement
-  auto movement = penguin->AddComponent<Movement>(PenguinBody::acceleration, PenguinBody::maxSpeed);
+  // Add movement (stopped by solid tiles)
+  auto movement = penguin->AddComponent<Movement>(PenguinBody::acceleration, PenguinBody::maxSpeed, true);
 
   // Add behavior
   penguin->AddComponent<::PenguinBody>(movement);
@@ -45,7 +45,7 @@ void Recipes::PenguinCannon(shared_ptr<GameObject> penguin)
   penguin->AddComponent<::PenguinCannon>();
 }
 
-auto Recipes::Text(string text, int size, Color color, Text::Style style) -> function<void(shared_ptr<GameObject>)>
+auto Recipes::Text(string text, int size, Color color, Text::Style style) -> Recipe
 {
   return [text, size, style, color](shared_ptr<GameObject> textObject)
   {
@@ -54,7 +54,7 @@ auto Recipes::Text(string text, int size, Color color, Text::Style style) -> fun
   };
 }
 
-auto Recipes::Background(string imagePath) -> function<void(shared_ptr<GameObject>)>
+auto Recipes::Background(string imagePath) -> Recipe
 {
   return [imagePath](shared_ptr<GameObject> background)
   {
@@ -83,8 +83,8 @@ void Recipes::Alien(shared_ptr<GameObject> alien)
   // Get alien sprite
   auto sprite = alien->AddComponent<Sprite>("./assets/image/alien.png", RenderLayer::Enemies);
 
-  // Get collider
-  alien->AddComponent<Collider>(sprite);
+  // Get collider (it's round)
+  alien->AddComponent<Collider>(sprite, Vector2::One(), ColliderShape::Circle)->layer = CollisionLayer::Enemies;
 
   // Get alien behavior
   alien->AddComponent<::Alien>();
@@ -102,15 +102,15 @@ void Recipes::Alien(shared_ptr<GameObject> alien)
   alien->tag = Tag::Enemy;
 }
 
-auto Recipes::Minion(shared_ptr<::Alien> alien, float startingArc) -> function<void(shared_ptr<GameObject>)>
+auto Recipes::Minion(shared_ptr<::Alien> alien, float startingArc) -> Recipe
 {
   return [alien, startingArc](shared_ptr<GameObject> minion)
   {
     // Give it a sprite
     auto sprite = minion->AddComponent<Sprite>("./assets/image/minion.png", RenderLayer::Enemies);
 
-    // Get collider
-    minion->AddComponent<Collider>(sprite);
+    // Get collider (it's round)
+    minion->AddComponent<Collider>(sprite, Vector2::One(), ColliderShape::Circle)->layer = CollisionLayer::Enemies;
 
     // Give it minion behavior
     minion->AddComponent<::Minion>(alien->gameObject.GetShared(), startingArc);
@@ -130,7 +130,7 @@ auto Recipes::Minion(shared_ptr<::Alien> alien, float startingArc) -> function<v
 }
 
 auto Recipes::OneShotAnimation(string spritePath, Vector2 animationFrame, float animationSpeed)
-    -> function<void(shared_ptr<GameObject>)>
+    -> Recipe
 {
   return [spritePath, animationFrame, animationSpeed](shared_ptr<GameObject> animation)
   {
@@ -140,16 +140,11 @@ auto Recipes::OneShotAnimation(string spritePath, Vector2 animationFrame, float
     // Add animation
     auto animator = animation->AddComponent<SpriteAnimator>(sprite, animationFrame, animationSpeed);
 
-    // Get weak pointer to animation object
-    auto animationWeak = weak_ptr(animation);
-
     // Play boom
     animation->AddComponent<Sound>("./assets/sound/boom.wav");
 
     // Delete self on animation end
-    animator->OnCycleEnd.AddListener("One Shot Destructor", [animationWeak]()
-                                     { if (auto animation = animationWeak.lock()) 
-                                        animation->RequestDestroy(); });
+    animator->DestroyObjectOnCycleEnd();
   };
 }
 
@@ -161,7 +156,7 @@ auto Recipes::Projectile(string spritePath, Vector2 animationFrame, float animat
                          float damage,
                          weak_ptr<GameObject> target,
                          float chaseSteering)
-    -> function<void(shared_ptr<GameObject>)>
+    -> Recipe
 {
   return [targetTag, spritePath, animationFrame, animationSpeed, startingAngle, speed, timeToLive, damage, target, chaseSteering, loopAnimation](shared_ptr<GameObject> projectile)
   {
@@ -171,8 +166,15 @@ auto Recipes::Projectile(string spritePath, Vector2 animationFrame, float animat
     // Add animation
     auto animator = projectile->AddComponent<SpriteAnimator>(sprite, animationFrame, animationSpeed, loopAnimation);
 
-    // Get collider
-    projectile->AddComponent<Collider>(animator);
+    // Get collider (in the layer of whoever shot it, rounded along it's length)
+    auto collider = projectile->AddComponent<Collider>(animator, Vector2::One(), ColliderShape::Capsule);
+    collider->layer = targetTag == Tag::Enemy ? CollisionLayer::PlayerProjectiles : CollisionLayer::EnemyProjectiles;
+
+    // Sweep it, so that it can't skip past small targets at low frame rates
+    collider->continuous = true;
+
+    // It's always in flight, so it never sleeps
+    collider->bodyType = BodyType::Kinematic;
 
     // Add projectile behavior
     projectile->AddComponent<::Projectile>(startingAngle, speed, timeToLive, target, chaseSteering);
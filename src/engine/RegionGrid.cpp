@@ -0,0 +1,165 @@
+#include "RegionGrid.h"
+#include "GameObject.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Packs region coordinates into a key
+static int64_t MakeKey(int x, int y) { return ((int64_t)x << 32) | (uint32_t)y; }
+
+void RegionGrid::Configure(Vector2 origin, Vector2 tileSize, int tilesPerRegion, float activationRadius)
+{
+  ASSERT(tilesPerRegion > 0 && tileSize.x > 0 && tileSize.y > 0, "Invalid region grid dimensions");
+
+  this->origin = origin;
+  this->regionSize = tileSize * tilesPerRegion;
+  this->activationRadius = activationRadius;
+
+  configured = true;
+}
+
+void RegionGrid::Track(shared_ptr<GameObject> object)
+{
+  if (configured)
+    newObjects.push_back(object);
+}
+
+int64_t RegionGrid::GetKey(Vector2 position) const
+{
+  return MakeKey(floor((position.x - origin.x) / regionSize.x), floor((position.y - origin.y) / regionSize.y));
+}
+
+void RegionGrid::ActivateAround(Vector2 position)
+{
+  // Region coordinates of the bounding box of the activation circle
+  int minX = floor((position.x - activationRadius - origin.x) / regionSize.x);
+  int maxX = floor((position.x + activationRadius - origin.x) / regionSize.x);
+  int minY = floor((position.y - activationRadius - origin.y) / regionSize.y);
+  int maxY = floor((position.y + activationRadius - origin.y) / regionSize.y);
+
+  for (int x = minX; x <= maxX; x++)
+    for (int y = minY; y <= maxY; y++)
+    {
+      // Closest point of the region to the position
+      float left = origin.x + x * regionSize.x, top = origin.y + y * regionSize.y;
+      Vector2 closest{clamp(position.x, left, left + regionSize.x), clamp(position.y, top, top + regionSize.y)};
+
+      if (Vector2::SqrDistance(closest, position) <= activationRadius * activationRadius)
+        nextActiveRegions.push_back(MakeKey(x, y));
+    }
+}
+
+void RegionGrid::Update(Vector2 cameraCenter)
+{
+  if (configured == false)
+    return;
+
+  // Find which regions are active this frame
+  nextActiveRegions.clear();
+
+  ActivateAround(cameraCenter);
+
+  auto anchorIterator = anchors.begin();
+  while (anchorIterator != anchors.end())
+  {
+    if (auto anchor = anchorIterator->lock())
+    {
+      ActivateAround(anchor->GetPosition());
+      anchorIterator++;
+    }
+    else
+      anchorIterator = anchors.erase(anchorIterator);
+  }
+
+  sort(nextActiveRegions.begin(), nextActiveRegions.end());
+  nextActiveRegions.erase(unique(nextActiveRegions.begin(), nextActiveRegions.end()), nextActiveRegions.end());
+
+  // Put to sleep the regions that are no longer active
+  changedRegions.clear();
+  set_difference(activeRegions.begin(), activeRegions.end(), nextActiveRegions.begin(), nextActiveRegions.end(), back_inserter(changedRegions));
+
+  for (auto key : changedRegions)
+    SetRegionAsleep(key, true);
+
+  // Wake up the ones that just became active
+  changedRegions.clear();
+  set_difference(nextActiveRegions.begin(), nextActiveRegions.end(), activeRegions.begin(), activeRegions.end(), back_inserter(changedRegions));
+
+  for (auto key : changedRegions)
+    SetRegionAsleep(key, false);
+
+  swap(activeRegions, nextActiveRegions);
+
+  // Place new objects
+  for (auto &objectWeak : newObjects)
+    if (auto object = objectWeak.lock())
+    {
+      int64_t key = GetKey(object->GetPosition());
+
+      regions[key].push_back(object);
+      object->SetAsleep(binary_search(activeRegions.begin(), activeRegions.end(), key) == false);
+    }
+
+  newObjects.clear();
+
+  // Only awake objects move, so only active regions need to be checked
+  for (auto key : activeRegions)
+    RelocateObjects(key);
+}
+
+void RegionGrid::SetRegionAsleep(int64_t key, bool asleep)
+{
+  auto regionIterator = regions.find(key);
+
+  if (regionIterator == regions.end())
+    return;
+
+  auto &objects = regionIterator->second;
+
+  auto objectIterator = objects.begin();
+  while (objectIterator != objects.end())
+  {
+    if (auto object = objectIterator->lock())
+    {
+      object->SetAsleep(asleep);
+      objectIterator++;
+    }
+    else
+      objectIterator = objects.erase(objectIterator);
+  }
+}
+
+void RegionGrid::RelocateObjects(int64_t key)
+{
+  auto regionIterator = regions.find(key);
+
+  if (regionIterator == regions.end())
+    return;
+
+  auto &objects = regionIterator->second;
+
+  for (size_t index = 0; index < objects.size();)
+  {
+    auto object = objects[index].lock();
+    int64_t newKey = object ? GetKey(object->GetPosition()) : key;
+
+    // Keep objects that stayed
+    if (object && newKey == key)
+    {
+      index++;
+      continue;
+    }
+
+    // Move it to it's new region, sleeping if that one is inactive
+    if (object)
+    {
+      regions[newKey].push_back(object);
+      object->SetAsleep(binary_search(activeRegions.begin(), activeRegions.end(), newKey) == false);
+    }
+
+    // Remove it from this one (order doesn't matter)
+    objects[index] = move(objects.back());
+    objects.pop_back();
+  }
+}
@@ -18,7 +18,7 @@ Resources::table<TTF_Font> Resources::fontTable;
 
 shared_ptr<SDL_Texture> Resources::GetTexture(string filename)
 {
-  function<SDL_Texture *(string)> textureLoader = [](string filename)
+  Delegate<SDL_Texture *(string)> textureLoader = [](string filename)
   {
     // Get the game renderer
     SDL_Renderer *renderer = Game::GetInstance().GetRenderer();
@@ -32,7 +32,7 @@ shared_ptr<SDL_Texture> Resources::GetTexture(string filename)
 
 shared_ptr<Mix_Music> Resources::GetMusic(string filename)
 {
-  function<Mix_Music *(string)> musicLoader = [](string filename)
+  Delegate<Mix_Music *(string)> musicLoader = [](string filename)
   {
     return Mix_LoadMUS(filename.c_str());
   };
@@ -42,7 +42,7 @@ shared_ptr<Mix_Music> Resources::GetMusic(string filename)
 
 shared_ptr<Mix_Chunk> Resources::GetSound(string filename)
 {
-  function<Mix_Chunk *(string)> chunkLoader = [](string filename)
+  Delegate<Mix_Chunk *(string)> chunkLoader = [](string filename)
   {
     return Mix_LoadWAV(filename.c_str());
   };
@@ -52,7 +52,7 @@ shared_ptr<Mix_Chunk> Resources::GetSound(string filename)
 
 shared_ptr<TTF_Font> Resources::GetFont(string filename, int size)
 {
-  function<TTF_Font *(string)> fontLoader = [](string fontKey)
+  Delegate<TTF_Font *(string)> fontLoader = [](string fontKey)
   {
     // Get the filename and the size
     size_t delimiter = fontKey.find_first_of("$");
@@ -0,0 +1,327 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include "SatCollision.h"
+#include "Helper.h"
+#include "Random.h"
+
+#if defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace Helper;
+
+OrientedBox::OrientedBox(const Rectangle &box, float rotation)
+    : center(box.Center()), cosine(cos(rotation)), sine(sin(rotation)), halfWidth(box.width / 2), halfHeight(box.height / 2) {}
+
+void OrientedBoxBatch::Clear()
+{
+  centerX.clear();
+  centerY.clear();
+  cosine.clear();
+  sine.clear();
+  halfWidth.clear();
+  halfHeight.clear();
+}
+
+void OrientedBoxBatch::Add(const OrientedBox &box)
+{
+  centerX.push_back(box.center.x);
+  centerY.push_back(box.center.y);
+  cosine.push_back(box.cosine);
+  sine.push_back(box.sine);
+  halfWidth.push_back(box.halfWidth);
+  halfHeight.push_back(box.halfHeight);
+}
+
+// Tests the box against another given by it's fields
+// The vector versions below do these very operations in this very order, so that they give the same results
+static bool Collide(const OrientedBox &box, float centerX, float centerY, float cosine2, float sine2, float halfWidth2, float halfHeight2)
+{
+  float deltaX = centerX - box.center.x, deltaY = centerY - box.center.y;
+
+  // How much each box's axes lean on the other's
+  float cosine = abs(box.cosine * cosine2 + box.sine * sine2);
+  float sine = abs(box.sine * cosine2 - box.cosine * sine2);
+
+  // Distance between the centers along each axis
+  float along1X = abs(deltaX * box.cosine + deltaY * box.sine);
+  float along1Y = abs(deltaY * box.cosine - deltaX * box.sine);
+  float along2X = abs(deltaX * cosine2 + deltaY * sine2);
+  float along2Y = abs(deltaY * cosine2 - deltaX * sine2);
+
+  // Compare them with the sum of both extents along that axis
+  return along1X <= box.halfWidth + (halfWidth2 * cosine + halfHeight2 * sine) &&
+         along1Y <= box.halfHeight + (halfWidth2 * sine + halfHeight2 * cosine) &&
+         along2X <= halfWidth2 + (box.halfWidth * cosine + box.halfHeight * sine) &&
+         along2Y <= halfHeight2 + (box.halfWidth * sine + box.halfHeight * cosine);
+}
+
+bool SatCollision::IsColliding(const OrientedBox &box1, const OrientedBox &box2)
+{
+  return Collide(box1, box2.center.x, box2.center.y, box2.cosine, box2.sine, box2.halfWidth, box2.halfHeight);
+}
+
+float SatCollision::FindSeparation(const OrientedBox &box1, const OrientedBox &box2)
+{
+  Vector2 delta = box2.center - box1.center;
+  float cosine = abs(box1.cosine * box2.cosine + box1.sine * box2.sine);
+  float sine = abs(box1.sine * box2.cosine - box1.cosine * box2.sine);
+
+  float gap1X = abs(delta.x * box1.cosine + delta.y * box1.sine) - (box1.halfWidth + (box2.halfWidth * cosine + box2.halfHeight * sine));
+  float gap1Y = abs(delta.y * box1.cosine - delta.x * box1.sine) - (box1.halfHeight + (box2.halfWidth * sine + box2.halfHeight * cosine));
+  float gap2X = abs(delta.x * box2.cosine + delta.y * box2.sine) - (box2.halfWidth + (box1.halfWidth * cosine + box1.halfHeight * sine));
+  float gap2Y = abs(delta.y * box2.cosine - delta.x * box2.sine) - (box2.halfHeight + (box1.halfWidth * sine + box1.halfHeight * cosine));
+
+  return max(max(gap1X, gap1Y), max(gap2X, gap2Y));
+}
+
+void SatCollision::CollideManyScalar(const OrientedBox &box, const OrientedBoxBatch &others, uint8_t *results)
+{
+  for (size_t index = 0; index < others.Size(); index++)
+    results[index] = Collide(box, others.centerX[index], others.centerY[index], others.cosine[index], others.sine[index],
+                             others.halfWidth[index], others.halfHeight[index]);
+}
+
+// Vector instructions of a given width, for CollideLanes
+#ifdef __SSE2__
+struct SseLanes
+{
+  using Value = __m128;
+  static const int width{4};
+
+  static Value Load(const float *values) { return _mm_loadu_ps(values); }
+  static Value Set(float value) { return _mm_set1_ps(value); }
+  static Value Add(Value a, Value b) { return _mm_add_ps(a, b); }
+  static Value Sub(Value a, Value b) { return _mm_sub_ps(a, b); }
+  static Value Mul(Value a, Value b) { return _mm_mul_ps(a, b); }
+  static Value Abs(Value a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static Value LessEqual(Value a, Value b) { return _mm_cmple_ps(a, b); }
+  static Value And(Value a, Value b) { return _mm_and_ps(a, b); }
+  static int Mask(Value a) { return _mm_movemask_ps(a); }
+};
+#endif
+
+#ifdef __AVX__
+struct AvxLanes
+{
+  using Value = __m256;
+  static const int width{8};
+
+  static Value Load(const float *values) { return _mm256_loadu_ps(values); }
+  static Value Set(float value) { return _mm256_set1_ps(value); }
+  static Value Add(Value a, Value b) { return _mm256_add_ps(a, b); }
+  static Value Sub(Value a, Value b) { return _mm256_sub_ps(a, b); }
+  static Value Mul(Value a, Value b) { return _mm256_mul_ps(a, b); }
+  static Value Abs(Value a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static Value LessEqual(Value a, Value b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static Value And(Value a, Value b) { return _mm256_and_ps(a, b); }
+  static int Mask(Value a) { return _mm256_movemask_ps(a); }
+};
+#endif
+
+// Collide, on as many of the batch's boxes at once as the lanes hold, starting from the given index
+// Returns the index of the first box left out (those that don't fill the lanes)
+template <class Lanes>
+static size_t CollideLanes(const OrientedBox &box, const OrientedBoxBatch &others, uint8_t *results, size_t index)
+{
+  using L = Lanes;
+
+  typename L::Value centerX1 = L::Set(box.center.x), centerY1 = L::Set(box.center.y);
+  typename L::Value cosine1 = L::Set(box.cosine), sine1 = L::Set(box.sine);
+  typename L::Value halfWidth1 = L::Set(box.halfWidth), halfHeight1 = L::Set(box.halfHeight);
+
+  for (; index + L::width <= others.Size(); index += L::width)
+  {
+    typename L::Value cosine2 = L::Load(&others.cosine[index]), sine2 = L::Load(&others.sine[index]);
+    typename L::Value halfWidth2 = L::Load(&others.halfWidth[index]), halfHeight2 = L::Load(&others.halfHeight[index]);
+
+    typename L::Value deltaX = L::Sub(L::Load(&others.centerX[index]), centerX1);
+    typename L::Value deltaY = L::Sub(L::Load(&others.centerY[index]), centerY1);
+
+    typename L::Value cosine = L::Abs(L::Add(L::Mul(cosine1, cosine2), L::Mul(sine1, sine2)));
+    typename L::Value sine = L::Abs(L::Sub(L::Mul(sine1, cosine2), L::Mul(cosine1, sine2)));
+
+    typename L::Value along1X = L::Abs(L::Add(L::Mul(deltaX, cosine1), L::Mul(deltaY, sine1)));
+    typename L::Value along1Y = L::Abs(L::Sub(L::Mul(deltaY, cosine1), L::Mul(deltaX, sine1)));
+    typename L::Value along2X = L::Abs(L::Add(L::Mul(deltaX, cosine2), L::Mul(deltaY, sine2)));
+    typename L::Value along2Y = L::Abs(L::Sub(L::Mul(deltaY, cosine2), L::Mul(deltaX, sine2)));
+
+    typename L::Value colliding =
+        L::LessEqual(along1X, L::Add(halfWidth1, L::Add(L::Mul(halfWidth2, cosine), L::Mul(halfHeight2, sine))));
+    colliding = L::And(colliding,
+                       L::LessEqual(along1Y, L::Add(halfHeight1, L::Add(L::Mul(halfWidth2, sine), L::Mul(halfHeight2, cosine)))));
+    colliding = L::And(colliding,
+                       L::LessEqual(along2X, L::Add(halfWidth2, L::Add(L::Mul(halfWidth1, cosine), L::Mul(halfHeight1, sine)))));
+    colliding = L::And(colliding,
+                       L::LessEqual(along2Y, L::Add(halfHeight2, L::Add(L::Mul(halfWidth1, sine), L::Mul(halfHeight1, cosine)))));
+
+    int mask = L::Mask(colliding);
+
+    for (int lane = 0; lane < L::width; lane++)
+      results[index + lane] = (mask >> lane) & 1;
+  }
+
+  return index;
+}
+
+void SatCollision::CollideMany(const OrientedBox &box, const OrientedBoxBatch &others, uint8_t *results)
+{
+  size_t index = 0;
+
+#ifdef __AVX__
+  index = CollideLanes<AvxLanes>(box, others, results, index);
+#endif
+
+#ifdef __SSE2__
+  index = CollideLanes<SseLanes>(box, others, results, index);
+#endif
+
+  // What doesn't fill the lanes
+  for (; index < others.Size(); index++)
+    results[index] = Collide(box, others.centerX[index], others.centerY[index], others.cosine[index], others.sine[index],
+                             others.halfWidth[index], others.halfHeight[index]);
+}
+
+// Boxes of very uneven shapes & rotations, close enough that about half of them collide
+// snapped: whole coordinates & sizes, and rotations of right angles
+static void RandomBoxes(int boxCount, bool snapped, vector<Rectangle> &rectangles, vector<float> &rotations, OrientedBoxBatch &batch)
+{
+  rectangles.resize(boxCount);
+  rotations.resize(boxCount);
+  batch.Clear();
+
+  for (int index = 0; index < boxCount; index++)
+  {
+    rectangles[index] = Rectangle(RandomRange(-100.0f, 100.0f), RandomRange(-100.0f, 100.0f), RandomRange(1.0f, 120.0f), RandomRange(1.0f, 120.0f));
+    rotations[index] = RandomRange(-4.0f, 4.0f);
+
+    if (snapped)
+    {
+      rectangles[index] = Rectangle(round(rectangles[index].x), round(rectangles[index].y), round(rectangles[index].width), round(rectangles[index].height));
+      rotations[index] = round(rotations[index] / (M_PI / 2)) * (M_PI / 2);
+    }
+
+    batch.Add(OrientedBox(rectangles[index], rotations[index]));
+  }
+}
+
+// Tests every box against all of them with both versions, throwing if they disagree, and returns how many pairs collide
+static size_t CompareKernels(const vector<Rectangle> &rectangles, const vector<float> &rotations, const OrientedBoxBatch &batch)
+{
+  int boxCount = rectangles.size();
+  vector<uint8_t> vectorResults(boxCount), scalarResults(boxCount);
+
+  // Both versions must agree exactly, including on touching boxes
+  size_t hits = 0;
+
+  for (int first = 0; first < boxCount; first++)
+  {
+    OrientedBox box(rectangles[first], rotations[first]);
+
+    SatCollision::CollideMany(box, batch, vectorResults.data());
+    SatCollision::CollideManyScalar(box, batch, scalarResults.data());
+
+    for (int second = 0; second < boxCount; second++)
+    {
+      CHECK(vectorResults[second] == scalarResults[second], "SAT kernels disagree on boxes ", first, " & ", second);
+      CHECK(scalarResults[second] == SatCollision::IsColliding(rectangles[first], rectangles[second], rotations[first], rotations[second]),
+            "SAT batch disagrees with pair test on boxes ", first, " & ", second);
+
+      hits += scalarResults[second];
+    }
+  }
+
+  return hits;
+}
+
+void SatCollision::Check(int boxCount, int rounds, uint64_t seed)
+{
+  Random::Seed(seed);
+
+  vector<Rectangle> rectangles;
+  vector<float> rotations;
+  OrientedBoxBatch batch;
+  size_t hits = 0;
+
+  for (int index = 0; index < rounds; index++)
+  {
+    RandomBoxes(boxCount, index % 2 == 1, rectangles, rotations, batch);
+    hits += CompareKernels(rectangles, rotations, batch);
+  }
+
+  cout << "SAT check: the kernels agree on " << rounds << " rounds of " << boxCount << " boxes (seed " << seed << ", "
+       << hits << " colliding pairs)" << endl;
+}
+
+void SatCollision::Benchmark(int boxCount, int iterations)
+{
+  using Clock = chrono::steady_clock;
+
+  vector<Rectangle> rectangles;
+  vector<float> rotations;
+  OrientedBoxBatch batch;
+
+  RandomBoxes(boxCount, false, rectangles, rotations, batch);
+
+  size_t hits = CompareKernels(rectangles, rotations, batch);
+
+  vector<uint8_t> vectorResults(boxCount), scalarResults(boxCount);
+
+  // Times the given way of testing every box against all of them
+  auto Time = [&](const char *name, auto test)
+  {
+    auto start = Clock::now();
+    size_t found = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+      found += test();
+
+    double time = chrono::duration<double, micro>(Clock::now() - start).count() / iterations;
+
+    CHECK(found == hits * iterations, name, " found ", found / iterations, " hits instead of ", hits);
+
+    cout << "  " << name << ": " << time / ((double)boxCount * boxCount) * 1000 << "ns per pair" << endl;
+  };
+
+  cout << "SAT benchmark: " << boxCount << " boxes against each other, " << hits << " colliding pairs" << endl;
+
+  Time("rectangle pairs", [&]()
+       {
+         size_t found = 0;
+
+         for (int first = 0; first < boxCount; first++)
+           for (int second = 0; second < boxCount; second++)
+             found += IsColliding(rectangles[first], rectangles[second], rotations[first], rotations[second]);
+
+         return found; });
+
+  Time("scalar batch", [&]()
+       {
+         size_t found = 0;
+
+         for (int first = 0; first < boxCount; first++)
+         {
+           CollideManyScalar(OrientedBox(rectangles[first], rotations[first]), batch, scalarResults.data());
+
+           for (uint8_t result : scalarResults)
+             found += result;
+         }
+
+         return found; });
+
+  Time("vector batch", [&]()
+       {
+         size_t found = 0;
+
+         for (int first = 0; first < boxCount; first++)
+         {
+           CollideMany(OrientedBox(rectangles[first], rotations[first]), batch, vectorResults.data());
+
+           for (uint8_t result : vectorResults)
+             found += result;
+         }
+
+         return found; });
+}
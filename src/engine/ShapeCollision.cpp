@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cmath>
+#include "ShapeCollision.h"
+
+using namespace std;
+
+// Most steps taken to find a time of impact
+static const int timeOfImpactSteps{32};
+
+// How close shapes have to be for a time of impact to be taken as found, in pixels
+static const float timeOfImpactTolerance{0.05f};
+
+// A segment widened by a radius (a circle when both ends meet)
+struct Capsule
+{
+  Vector2 start, end;
+  float radius;
+};
+
+// Cross product of the two vectors (positive when the second is clockwise from the first, on screen)
+static float Cross(const Vector2 &vector1, const Vector2 &vector2) { return vector1.x * vector2.y - vector1.y * vector2.x; }
+
+static Capsule CapsuleOf(ColliderShape shape, const OrientedBox &box)
+{
+  float radius = min(box.halfWidth, box.halfHeight);
+
+  if (shape == ColliderShape::Circle)
+    return Capsule{box.center, box.center, radius};
+
+  // Along the longest side
+  Vector2 halfSegment = box.halfWidth >= box.halfHeight ? Vector2(box.cosine, box.sine) * (box.halfWidth - radius)
+                                                        : Vector2(-box.sine, box.cosine) * (box.halfHeight - radius);
+
+  return Capsule{box.center - halfSegment, box.center + halfSegment, radius};
+}
+
+// Point in the box's own frame, where it's centered on the origin & unrotated
+static Vector2 ToBoxFrame(const OrientedBox &box, const Vector2 &point)
+{
+  Vector2 offset = point - box.center;
+
+  return Vector2(offset.x * box.cosine + offset.y * box.sine, offset.y * box.cosine - offset.x * box.sine);
+}
+
+static float SqrDistanceToSegment(const Vector2 &point, const Vector2 &start, const Vector2 &end)
+{
+  Vector2 segment = end - start;
+  float lengthSquared = segment.SqrMagnitude();
+  float along = lengthSquared > 0 ? clamp(Vector2::Dot(point - start, segment) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+
+  return Vector2::SqrDistance(point, start + segment * along);
+}
+
+static float SqrDistanceBetweenSegments(const Vector2 &start1, const Vector2 &end1, const Vector2 &start2, const Vector2 &end2)
+{
+  // Crossing segments have each one's ends on either side of the other
+  float side1 = Cross(end1 - start1, start2 - start1), side2 = Cross(end1 - start1, end2 - start1);
+  float side3 = Cross(end2 - start2, start1 - start2), side4 = Cross(end2 - start2, end1 - start2);
+
+  if (((side1 < 0 && side2 > 0) || (side1 > 0 && side2 < 0)) && ((side3 < 0 && side4 > 0) || (side3 > 0 && side4 < 0)))
+    return 0;
+
+  // Otherwise the closest points include an end of one of them
+  return min(min(SqrDistanceToSegment(start1, start2, end2), SqrDistanceToSegment(end1, start2, end2)),
+             min(SqrDistanceToSegment(start2, start1, end1), SqrDistanceToSegment(end2, start1, end1)));
+}
+
+// Distance from a point to the box, given in the box's frame
+static float SqrDistanceToBox(const OrientedBox &box, const Vector2 &localPoint)
+{
+  Vector2 closest(clamp(localPoint.x, -box.halfWidth, box.halfWidth), clamp(localPoint.y, -box.halfHeight, box.halfHeight));
+
+  return Vector2::SqrDistance(localPoint, closest);
+}
+
+// Distance from a segment to the box, given in the box's frame
+static float SqrDistanceSegmentToBox(const OrientedBox &box, const Vector2 &start, const Vector2 &end)
+{
+  // Clip the segment against each pair of sides: if anything is left, it crosses the box
+  Vector2 direction = end - start;
+  float enter = 0, exit = 1;
+  float starts[2]{start.x, start.y}, directions[2]{direction.x, direction.y}, halfSizes[2]{box.halfWidth, box.halfHeight};
+
+  for (int axis = 0; axis < 2 && enter <= exit; axis++)
+  {
+    if (directions[axis] == 0)
+    {
+      if (abs(starts[axis]) > halfSizes[axis])
+        exit = -1;
+
+      continue;
+    }
+
+    float time1 = (-halfSizes[axis] - starts[axis]) / directions[axis], time2 = (halfSizes[axis] - starts[axis]) / directions[axis];
+    enter = max(enter, min(time1, time2));
+    exit = min(exit, max(time1, time2));
+  }
+
+  if (enter <= exit)
+    return 0;
+
+  // Otherwise the closest points include an end of the segment or a corner of the box
+  float best = min(SqrDistanceToBox(box, start), SqrDistanceToBox(box, end));
+
+  for (Vector2 corner : {Vector2(box.halfWidth, box.halfHeight), Vector2(-box.halfWidth, box.halfHeight),
+                         Vector2(-box.halfWidth, -box.halfHeight), Vector2(box.halfWidth, -box.halfHeight)})
+    best = min(best, SqrDistanceToSegment(corner, start, end));
+
+  return best;
+}
+
+// Distance along a ray to where it enters a box centered on the origin, or -1 if it doesn't within the max distance
+static float RayToBox(float halfWidth, float halfHeight, const Vector2 &origin, const Vector2 &direction, float maxDistance)
+{
+  // Clip the ray against each pair of sides
+  float enter = 0, exit = maxDistance;
+  float origins[2]{origin.x, origin.y}, directions[2]{direction.x, direction.y}, halfSizes[2]{halfWidth, halfHeight};
+
+  for (int axis = 0; axis < 2 && enter <= exit; axis++)
+  {
+    if (directions[axis] == 0)
+    {
+      if (abs(origins[axis]) > halfSizes[axis])
+        return -1;
+
+      continue;
+    }
+
+    float distance1 = (-halfSizes[axis] - origins[axis]) / directions[axis], distance2 = (halfSizes[axis] - origins[axis]) / directions[axis];
+    enter = max(enter, min(distance1, distance2));
+    exit = min(exit, max(distance1, distance2));
+  }
+
+  return enter <= exit ? enter : -1;
+}
+
+// Distance along a ray (with a unit direction) to where it enters a circle, or -1 if it doesn't within the max distance
+static float RayToCircle(const Vector2 &center, float radius, const Vector2 &origin, const Vector2 &direction, float maxDistance)
+{
+  Vector2 offset = origin - center;
+  float along = Vector2::Dot(offset, direction), excess = offset.SqrMagnitude() - radius * radius;
+
+  if (excess <= 0)
+    return 0;
+
+  // Starting outside & heading away, or passing beside it
+  float discriminant = along * along - excess;
+
+  if (along > 0 || discriminant < 0)
+    return -1;
+
+  float distance = -along - sqrt(discriminant);
+
+  return distance <= maxDistance ? distance : -1;
+}
+
+bool ShapeCollision::IsColliding(ColliderShape shape1, const OrientedBox &box1, ColliderShape shape2, const OrientedBox &box2)
+{
+  if (shape1 == ColliderShape::Box && shape2 == ColliderShape::Box)
+    return SatCollision::IsColliding(box1, box2);
+
+  // Keep the box second, if any
+  if (shape1 == ColliderShape::Box)
+    return IsColliding(shape2, box2, shape1, box1);
+
+  Capsule capsule1 = CapsuleOf(shape1, box1);
+
+  // Round shape against a box
+  if (shape2 == ColliderShape::Box)
+  {
+    float distanceSquared = SqrDistanceSegmentToBox(box2, ToBoxFrame(box2, capsule1.start), ToBoxFrame(box2, capsule1.end));
+
+    return distanceSquared <= capsule1.radius * capsule1.radius;
+  }
+
+  // Two round shapes: compare the distance between their segments with the sum of their radii
+  Capsule capsule2 = CapsuleOf(shape2, box2);
+  float reach = capsule1.radius + capsule2.radius;
+
+  if (shape1 == ColliderShape::Circle && shape2 == ColliderShape::Circle)
+    return Vector2::SqrDistance(capsule1.start, capsule2.start) <= reach * reach;
+
+  if (shape1 == ColliderShape::Circle)
+    return SqrDistanceToSegment(capsule1.start, capsule2.start, capsule2.end) <= reach * reach;
+
+  if (shape2 == ColliderShape::Circle)
+    return SqrDistanceToSegment(capsule2.start, capsule1.start, capsule1.end) <= reach * reach;
+
+  return SqrDistanceBetweenSegments(capsule1.start, capsule1.end, capsule2.start, capsule2.end) <= reach * reach;
+}
+
+float ShapeCollision::FindDistance(ColliderShape shape1, const OrientedBox &box1, ColliderShape shape2, const OrientedBox &box2)
+{
+  if (shape1 == ColliderShape::Box && shape2 == ColliderShape::Box)
+    return SatCollision::FindSeparation(box1, box2);
+
+  if (shape1 == ColliderShape::Box)
+    return FindDistance(shape2, box2, shape1, box1);
+
+  Capsule capsule1 = CapsuleOf(shape1, box1);
+
+  if (shape2 == ColliderShape::Box)
+    return sqrt(SqrDistanceSegmentToBox(box2, ToBoxFrame(box2, capsule1.start), ToBoxFrame(box2, capsule1.end))) - capsule1.radius;
+
+  Capsule capsule2 = CapsuleOf(shape2, box2);
+
+  return sqrt(SqrDistanceBetweenSegments(capsule1.start, capsule1.end, capsule2.start, capsule2.end)) - capsule1.radius - capsule2.radius;
+}
+
+float ShapeCollision::FindTimeOfImpact(ColliderShape shape1, const OrientedBox &box1, Vector2 motion1,
+                                       ColliderShape shape2, const OrientedBox &box2, Vector2 motion2)
+{
+  // Move the first one only, by how they move relative to each other
+  Vector2 motion = motion1 - motion2;
+  float length = motion.Magnitude();
+  OrientedBox moved = box1;
+  float time = 0;
+
+  // Conservative advancement: the shapes can't touch before they've closed the distance between them,
+  // so it's always safe to move that much
+  for (int step = 0; step < timeOfImpactSteps; step++)
+  {
+    moved.center = box1.center + motion * time;
+    float distance = FindDistance(shape1, moved, shape2, box2);
+
+    if (distance <= timeOfImpactTolerance)
+      return time;
+
+    if (length == 0)
+      return -1;
+
+    time += distance / length;
+
+    if (time > 1)
+      return -1;
+  }
+
+  // Still closing in: settle it at the end of the motion
+  moved.center = box1.center + motion;
+
+  return IsColliding(shape1, moved, shape2, box2) ? 1 : -1;
+}
+
+float ShapeCollision::Raycast(ColliderShape shape, const OrientedBox &box, Vector2 origin, Vector2 direction, float maxDistance)
+{
+  // Work in the box's frame
+  Vector2 localOrigin = ToBoxFrame(box, origin);
+  Vector2 localDirection(direction.x * box.cosine + direction.y * box.sine, direction.y * box.cosine - direction.x * box.sine);
+
+  if (shape == ColliderShape::Box)
+    return RayToBox(box.halfWidth, box.halfHeight, localOrigin, localDirection, maxDistance);
+
+  float radius = min(box.halfWidth, box.halfHeight);
+
+  if (shape == ColliderShape::Circle)
+    return RayToCircle(Vector2(), radius, localOrigin, localDirection, maxDistance);
+
+  // A capsule is a box around it's segment, capped by a circle on each end
+  bool alongWidth = box.halfWidth >= box.halfHeight;
+  Vector2 halfSegment = alongWidth ? Vector2(box.halfWidth - radius, 0) : Vector2(0, box.halfHeight - radius);
+  float best = -1;
+
+  for (float distance : {RayToBox(alongWidth ? halfSegment.x : radius, alongWidth ? radius : halfSegment.y, localOrigin, localDirection, maxDistance),
+                         RayToCircle(halfSegment, radius, localOrigin, localDirection, maxDistance),
+                         RayToCircle(-halfSegment, radius, localOrigin, localDirection, maxDistance)})
+    if (distance >= 0 && (best < 0 || distance < best))
+      best = distance;
+
+  return best;
+}
+
+Bounds ShapeCollision::BoundsOf(ColliderShape shape, const OrientedBox &box)
+{
+  if (shape == ColliderShape::Box)
+  {
+    float cosine = abs(box.cosine), sine = abs(box.sine);
+    Vector2 halfSize(box.halfWidth * cosine + box.halfHeight * sine, box.halfWidth * sine + box.halfHeight * cosine);
+
+    return Bounds(box.center - halfSize, box.center + halfSize);
+  }
+
+  Capsule capsule = CapsuleOf(shape, box);
+
+  return Bounds(Vector2(min(capsule.start.x, capsule.end.x), min(capsule.start.y, capsule.end.y)),
+                Vector2(max(capsule.start.x, capsule.end.x), max(capsule.start.y, capsule.end.y)))
+      .Expanded(capsule.radius);
+}
+
+float ShapeCollision::BoundingRadiusOf(ColliderShape shape, float width, float height)
+{
+  if (shape == ColliderShape::Circle)
+    return min(width, height) / 2;
+
+  if (shape == ColliderShape::Capsule)
+    return max(width, height) / 2;
+
+  return sqrt(width * width + height * height) / 2;
+}
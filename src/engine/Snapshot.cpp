@@ -0,0 +1,507 @@
+#include <algorithm>
+#include <fstream>
+#include "Snapshot.h"
+#include "GameState.h"
+#include "ComponentRegistry.h"
+#include "BinaryStream.h"
+#include "Random.h"
+#include "Camera.h"
+
+using namespace std;
+
+// "WPSN", read as a little endian integer
+const uint32_t Snapshot::fileMagic{0x4e535057};
+const uint32_t Snapshot::fileVersion{11};
+
+// === SNAPSHOT =================================
+
+void Snapshot::Capture(GameState &state, bool withCallbacks)
+{
+  this->withCallbacks = withCallbacks;
+
+  // Keep the capacity from the last capture
+  data.clear();
+  objects.clear();
+
+  BinaryWriter writer(data);
+
+  writer.Write(Random::GetState());
+
+  Camera &camera = Camera::GetInstance();
+  writer.Write(camera.GetRawPosition());
+  writer.Write(camera.speed);
+
+  state.timer.SaveState(writer, withCallbacks);
+  state.SaveState(writer);
+
+  // Collision contacts, so that lasting ones aren't taken as new once restored
+  writer.Write((uint32_t)state.contacts.size());
+
+  for (auto [objectId1, objectId2] : state.contacts)
+  {
+    writer.Write(objectId1);
+    writer.Write(objectId2);
+  }
+
+  // Timed callbacks live in the wheel, so it's copied as a whole
+  if (withCallbacks)
+    wheel = state.timingWheel;
+
+  // Save objects sorted by id, so that parents are rebuilt before their children
+  objectBuffer.clear();
+
+  // (the root isn't listed among them)
+  for (auto &[id, object] : state.gameObjects)
+    objectBuffer.push_back(object.get());
+
+  sort(objectBuffer.begin(), objectBuffer.end(), [](GameObject *first, GameObject *second)
+       { return first->id < second->id; });
+
+  for (auto object : objectBuffer)
+  {
+    objects.push_back(ObjectRecord{object->id, data.size()});
+    SaveObject(*object, writer);
+  }
+}
+
+void Snapshot::SaveObject(GameObject &object, BinaryWriter &writer)
+{
+  // Component types come first, so that they can be matched without reading the rest
+  writer.Write<uint32_t>(object.components.size());
+
+  for (auto &component : object.components)
+    writer.Write(ComponentRegistry::GetId(*component));
+
+  writer.Write(object.name);
+  // Every listed object has a parent (the root at least)
+  writer.Write(object.weakParent.lock()->id);
+  writer.Write(object.localPosition);
+  writer.Write(object.localScale);
+  writer.Write(object.localRotation);
+  writer.Write(object.tag);
+  writer.Write(object.enabled);
+  writer.Write(object.asleep);
+
+  object.timer.SaveState(writer, withCallbacks);
+
+  // Writes a size placeholder, and fills it in once the block is written
+  auto WriteBlock = [&writer](const auto &writeContents)
+  {
+    size_t sizePosition = writer.Size();
+    writer.Write<uint32_t>(0);
+
+    writeContents();
+
+    writer.Patch<uint32_t>(sizePosition, writer.Size() - sizePosition - sizeof(uint32_t));
+  };
+
+  for (auto &component : object.components)
+  {
+    writer.Write(component->enabled);
+    writer.Write(component->pendingDeltaTime);
+    writer.Write(component->waitedFrames);
+
+    WriteBlock([&]()
+               { component->SaveConstruction(writer); });
+    WriteBlock([&]()
+               { component->SaveState(writer); });
+  }
+}
+
+bool Snapshot::Matches(GameObject &object, const ObjectRecord &record) const
+{
+  BinaryReader reader(data.data() + record.offset, data.size() - record.offset);
+
+  if (reader.Read<uint32_t>() != object.components.size())
+    return false;
+
+  for (auto &component : object.components)
+    if (reader.Read<int>() != ComponentRegistry::GetId(*component))
+      return false;
+
+  return true;
+}
+
+void Snapshot::Restore(GameState &state)
+{
+  ASSERT(IsEmpty() == false, "Tried to restore a snapshot which was never captured");
+
+  // Tells whether the snapshot has this object
+  auto FindRecord = [this](int id)
+  {
+    auto record = lower_bound(objects.begin(), objects.end(), id, [](const ObjectRecord &record, int id)
+                              { return record.id < id; });
+
+    return record != objects.end() && record->id == id ? &*record : nullptr;
+  };
+
+  // Remove objects which didn't exist back then, or which changed too much to be restored in place
+  // They are removed silently: as far as the snapshot is concerned, they were never there
+  objectBuffer.clear();
+
+  for (auto &[id, object] : state.gameObjects)
+  {
+    auto record = FindRecord(id);
+
+    if (record == nullptr || Matches(*object, *record) == false)
+      objectBuffer.push_back(object.get());
+  }
+
+  // Hold them until all are unlinked, as their children may be among them
+  vector<shared_ptr<GameObject>> removedObjects;
+  removedObjects.reserve(objectBuffer.size());
+
+  for (auto object : objectBuffer)
+  {
+    removedObjects.push_back(state.gameObjects[object->id]);
+
+    if (auto parent = object->weakParent.lock())
+      parent->children.erase(object->id);
+
+    state.gameObjects.erase(object->id);
+  }
+
+  // Their timers cancel their callbacks in the current wheel, so let go of them before it's replaced
+  removedObjects.clear();
+
+  // Go back to the saved schedule (timers load against it's clock)
+  if (withCallbacks)
+    state.timingWheel.Restore(wheel);
+  else
+    state.timingWheel.Clear();
+
+  BinaryReader reader(data);
+
+  uint64_t randomState = reader.Read<uint64_t>();
+  Vector2 cameraPosition = reader.ReadVector2();
+  Vector2 cameraSpeed = reader.ReadVector2();
+
+  state.timer.LoadState(reader, withCallbacks);
+  state.LoadState(reader);
+
+  state.contacts.resize(reader.Read<uint32_t>());
+
+  for (auto &contact : state.contacts)
+  {
+    contact.first = reader.Read<int>();
+    contact.second = reader.Read<int>();
+  }
+
+  // Load each object, rebuilding the missing ones
+  parentIds.resize(objects.size());
+  rebuilt.assign(objects.size(), false);
+  state.gameObjects.reserve(objects.size());
+
+  // Rebuilt ids must not be given out again
+  if (objects.empty() == false)
+    state.nextObjectId = max(state.nextObjectId, objects.back().id + 1);
+
+  for (size_t index = 0; index < objects.size(); index++)
+  {
+    int id = objects[index].id;
+    auto objectIterator = state.gameObjects.find(id);
+    shared_ptr<GameObject> object;
+
+    BinaryReader objectReader(data.data() + objects[index].offset, data.size() - objects[index].offset);
+
+    if (objectIterator == state.gameObjects.end())
+    {
+      // Peek the name, which comes after the component types
+      BinaryReader nameReader = objectReader;
+      nameReader.Skip(nameReader.Read<uint32_t>() * sizeof(int));
+
+      object = state.RegisterObject(new GameObject(nameReader.ReadString(), state, id));
+      rebuilt[index] = true;
+    }
+    else
+      object = objectIterator->second;
+
+    parentIds[index] = LoadObject(*object, objectReader, rebuilt[index]);
+  }
+
+  // Relink the hierarchy
+  for (size_t index = 0; index < objects.size(); index++)
+    state.gameObjects[objects[index].id]->children.clear();
+
+  state.rootObject->children.clear();
+
+  for (size_t index = 0; index < objects.size(); index++)
+  {
+    auto object = state.gameObjects[objects[index].id];
+    auto parent = parentIds[index] == state.rootObject->id ? state.rootObject : state.gameObjects[parentIds[index]];
+
+    object->weakParent = parent;
+    parent->children[object->id] = object;
+
+    if (rebuilt[index] == false)
+      continue;
+
+    // Register rebuilt objects as Start would, without calling it (their state is already loaded)
+    object->started = true;
+
+    for (auto &component : object->components)
+    {
+      component->started = true;
+
+      if (component->GetRenderLayer() != RenderLayer::None)
+        state.RegisterLayerRenderer(component);
+
+      if (auto collider = dynamic_pointer_cast<Collider>(component))
+        state.RegisterCollider(*collider);
+    }
+
+    if (parent->IsRoot())
+      state.regionGrid.Track(object);
+  }
+
+  Camera::GetInstance().SetRawPosition(cameraPosition);
+  Camera::GetInstance().speed = cameraSpeed;
+
+  // Now that every object is back, let components find each other again
+  for (auto &record : objects)
+    for (auto &component : state.gameObjects[record.id]->components)
+      component->OnRestore();
+
+  state.OnRestore();
+
+  // Last, as rebuilding & restoring may have drawn numbers
+  Random::SetState(randomState);
+}
+
+int Snapshot::LoadObject(GameObject &object, BinaryReader &reader, bool rebuild)
+{
+  // Component types
+  uint32_t componentCount = reader.Read<uint32_t>();
+  vector<int> &typeIds = typeIdBuffer;
+  typeIds.resize(componentCount);
+
+  for (auto &typeId : typeIds)
+    typeId = reader.Read<int>();
+
+  reader.ReadString();
+  int parentId = reader.Read<int>();
+  Vector2 localPosition = reader.ReadVector2();
+  Vector2 localScale = reader.ReadVector2();
+  double localRotation = reader.Read<double>();
+  object.tag = reader.Read<Tag>();
+  object.enabled = reader.Read<bool>();
+  object.asleep = reader.Read<bool>();
+
+  object.timer.LoadState(reader, withCallbacks);
+
+  if (rebuild)
+  {
+    // The callbacks of a rebuilt object's timer were bound to the object it replaces
+    object.timer.CancelAll();
+
+    // Constructors may use the hierarchy, so give it it's parent right away (or the root, if the parent isn't back yet)
+    auto parent = object.gameState.gameObjects.find(parentId);
+    object.weakParent = parent != object.gameState.gameObjects.end() ? parent->second : object.gameState.rootObject;
+  }
+
+  for (uint32_t index = 0; index < componentCount; index++)
+  {
+    bool enabled = reader.Read<bool>();
+    float pendingDeltaTime = reader.Read<float>();
+    int waitedFrames = reader.Read<int>();
+
+    BinaryReader construction = reader.ReadBlock(reader.Read<uint32_t>());
+    BinaryReader stateReader = reader.ReadBlock(reader.Read<uint32_t>());
+
+    shared_ptr<Component> component;
+
+    if (rebuild)
+    {
+      component = ComponentRegistry::Create(typeIds[index], object, construction);
+
+      ASSERT(construction.AtEnd(), "Component ", ComponentRegistry::GetName(typeIds[index]), " didn't read back all of it's construction");
+    }
+    else
+      component = object.components[index];
+
+    component->enabled = enabled;
+    component->pendingDeltaTime = pendingDeltaTime;
+    component->waitedFrames = waitedFrames;
+
+    component->LoadState(stateReader);
+
+    ASSERT(stateReader.AtEnd(), "Component ", ComponentRegistry::GetName(typeIds[index]), " didn't read back all of it's state");
+  }
+
+  // Set last, as constructors may have changed them
+  object.localPosition = localPosition;
+  object.localScale = localScale;
+  object.localRotation = localRotation;
+
+  return parentId;
+}
+
+// === SCENE FILES =================================
+
+void Snapshot::WriteFile(const string &path) const
+{
+  ASSERT(IsEmpty() == false && withCallbacks == false, "Only snapshots captured without callbacks can be written to files");
+
+  vector<uint8_t> contents;
+  BinaryWriter writer(contents);
+
+  // Registry ids depend on the build, so the file refers to types by name, through a table
+  // Find which types are used, and where their ids are
+  vector<int> tableIndices, tableTypes;
+
+  for (auto &record : objects)
+  {
+    BinaryReader reader(data.data() + record.offset, data.size() - record.offset);
+    uint32_t componentCount = reader.Read<uint32_t>();
+
+    for (uint32_t index = 0; index < componentCount; index++)
+    {
+      int typeId = reader.Read<int>();
+
+      ASSERT(typeId >= 0, "Tried to write a component whose type isn't registered to a scene file");
+
+      if (typeId >= (int)tableIndices.size())
+        tableIndices.resize(typeId + 1, -1);
+
+      if (tableIndices[typeId] < 0)
+      {
+        tableIndices[typeId] = tableTypes.size();
+        tableTypes.push_back(typeId);
+      }
+    }
+  }
+
+  writer.Write(fileMagic);
+  writer.Write(fileVersion);
+
+  writer.Write<uint32_t>(tableTypes.size());
+
+  for (int typeId : tableTypes)
+    writer.Write(ComponentRegistry::GetName(typeId));
+
+  // Field by field & with fixed widths, so that files don't depend on padding or the size of size_t
+  writer.Write<uint32_t>(objects.size());
+
+  for (auto &record : objects)
+  {
+    writer.Write<int32_t>(record.id);
+    writer.Write<uint64_t>(record.offset);
+  }
+
+  writer.Write<uint64_t>(data.size());
+  size_t dataStart = writer.Size();
+  writer.WriteArray(data.data(), data.size());
+
+  // Swap registry ids for table indices
+  for (auto &record : objects)
+  {
+    size_t position = dataStart + record.offset;
+    uint32_t componentCount;
+    memcpy(&componentCount, contents.data() + position, sizeof(uint32_t));
+
+    for (uint32_t index = 0; index < componentCount; index++)
+    {
+      size_t idPosition = position + sizeof(uint32_t) + index * sizeof(int);
+      int typeId;
+      memcpy(&typeId, contents.data() + idPosition, sizeof(int));
+
+      writer.Patch(idPosition, tableIndices[typeId]);
+    }
+  }
+
+  ofstream file(path, ios::binary);
+  CHECK(file.is_open(), "Unable to write scene file ", path);
+
+  file.write((const char *)contents.data(), contents.size());
+}
+
+void Snapshot::ReadFile(const string &path)
+{
+  ifstream file(path, ios::binary | ios::ate);
+  CHECK(file.is_open(), "Unable to open scene file ", path);
+
+  // Read it all at once, into storage sized up front
+  vector<uint8_t> contents(file.tellg());
+  file.seekg(0);
+  file.read((char *)contents.data(), contents.size());
+
+  BinaryReader reader(contents);
+
+  CHECK(contents.size() >= 2 * sizeof(uint32_t) && reader.Read<uint32_t>() == fileMagic, path, " isn't a scene file");
+
+  uint32_t version = reader.Read<uint32_t>();
+  CHECK(version == fileVersion, "Scene file ", path, " has version ", version, ", but version ", fileVersion, " is expected");
+
+  // Find the registry id of each type in the table
+  vector<int> tableTypes(reader.Read<uint32_t>());
+
+  for (auto &typeId : tableTypes)
+  {
+    string name = reader.ReadString();
+    typeId = ComponentRegistry::GetId(name);
+
+    CHECK(typeId >= 0, "Scene file ", path, " has components of type ", name, ", which isn't registered");
+  }
+
+  objects.resize(reader.Read<uint32_t>());
+
+  for (auto &record : objects)
+  {
+    record.id = reader.Read<int32_t>();
+    record.offset = reader.Read<uint64_t>();
+  }
+
+  data.resize(reader.Read<uint64_t>());
+  reader.ReadArray(data.data(), data.size());
+
+  // Swap table indices back for registry ids
+  for (auto &record : objects)
+  {
+    CHECK(record.offset < data.size(), "Scene file ", path, " is corrupted");
+
+    BinaryReader recordReader(data.data() + record.offset, data.size() - record.offset);
+    uint32_t componentCount = recordReader.Read<uint32_t>();
+
+    for (uint32_t index = 0; index < componentCount; index++)
+    {
+      size_t idPosition = record.offset + recordReader.GetPosition();
+      int tableIndex = recordReader.Read<int>();
+
+      CHECK(tableIndex >= 0 && tableIndex < (int)tableTypes.size(), "Scene file ", path, " is corrupted");
+
+      memcpy(data.data() + idPosition, &tableTypes[tableIndex], sizeof(int));
+    }
+  }
+
+  withCallbacks = false;
+}
+
+// === ROLLBACK BUFFER =================================
+
+void RollbackBuffer::Record(GameState &state)
+{
+  if (snapshots.empty())
+    return;
+
+  newest = (newest + 1) % snapshots.size();
+  count = min(count + 1, (int)snapshots.size());
+
+  snapshots[newest].Capture(state);
+}
+
+bool RollbackBuffer::Rewind(GameState &state, int frames)
+{
+  if (frames < 1 || frames > count)
+    return false;
+
+  int capacity = snapshots.size();
+  int index = (newest - frames + 1 + capacity) % capacity;
+
+  snapshots[index].Restore(state);
+
+  // The rewound frames no longer happened
+  newest = (index - 1 + capacity) % capacity;
+  count -= frames;
+
+  return true;
+}
@@ -1,9 +1,19 @@
 #include "Sound.h"
 #include "Resources.h"
+#include "ComponentRegistry.h"
 
 using namespace Helper;
 using namespace std;
 
+static shared_ptr<Component> RebuildSound(GameObject &object, BinaryReader &reader)
+{
+  string path = reader.ReadString();
+
+  return object.AddComponent<Sound>(path, reader.Read<bool>());
+}
+
+REGISTER_COMPONENT(Sound, RebuildSound)
+
 Sound::Sound(GameObject &associatedObject, const string fileName, bool playOnStart) : Component(associatedObject), chunkPath(fileName), playOnStart(playOnStart) {}
 
 void Sound::Play(const int times)
@@ -33,4 +43,10 @@ void Sound::Start()
 {
   if (playOnStart)
     Play();
-}
\ No newline at end of file
+}
+
+void Sound::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(chunkPath);
+  writer.Write(playOnStart);
+}
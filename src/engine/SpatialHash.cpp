@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include "SpatialHash.h"
+#include "Helper.h"
+
+using namespace std;
+
+const float SpatialHash::defaultCellSize{128};
+
+static int64_t MakeKey(int x, int y) { return ((int64_t)x << 32) | (uint32_t)y; }
+
+void SpatialHash::SetCellSize(float cellSize)
+{
+  ASSERT(cellSize > 0, "Spatial hash cell size must be greater than zero");
+
+  this->cellSize = cellSize;
+}
+
+int SpatialHash::GetCell(float coordinate) const { return floor(coordinate / cellSize); }
+
+int SpatialHash::CreateProxy(const Bounds &bounds)
+{
+  int proxy;
+
+  if (freeProxies.empty())
+  {
+    proxy = proxies.size();
+    proxies.push_back(bounds);
+    used.push_back(true);
+  }
+  else
+  {
+    proxy = freeProxies.back();
+    freeProxies.pop_back();
+    proxies[proxy] = bounds;
+    used[proxy] = true;
+  }
+
+  return proxy;
+}
+
+void SpatialHash::MoveProxy(int proxy, const Bounds &bounds) { proxies[proxy] = bounds; }
+
+void SpatialHash::DestroyProxy(int proxy)
+{
+  used[proxy] = false;
+  freeProxies.push_back(proxy);
+}
+
+void SpatialHash::FindPairs(vector<pair<int, int>> &pairs)
+{
+  pairs.clear();
+  entries.clear();
+
+  // Put each proxy in the cells it overlaps
+  for (int proxy = 0; proxy < (int)proxies.size(); proxy++)
+  {
+    if (used[proxy] == false)
+      continue;
+
+    int minX = GetCell(proxies[proxy].min.x), maxX = GetCell(proxies[proxy].max.x);
+    int minY = GetCell(proxies[proxy].min.y), maxY = GetCell(proxies[proxy].max.y);
+
+    for (int x = minX; x <= maxX; x++)
+      for (int y = minY; y <= maxY; y++)
+        entries.push_back(Entry{MakeKey(x, y), proxy});
+  }
+
+  // Group them by cell (ties by id, so that pairs come out with the lowest id first)
+  sort(entries.begin(), entries.end(), [](const Entry &entry1, const Entry &entry2)
+       { return entry1.cellKey != entry2.cellKey ? entry1.cellKey < entry2.cellKey : entry1.proxy < entry2.proxy; });
+
+  // Pair up the proxies in each cell
+  for (size_t cellStart = 0, cellEnd = 0; cellStart < entries.size(); cellStart = cellEnd)
+  {
+    int64_t cellKey = entries[cellStart].cellKey;
+
+    while (cellEnd < entries.size() && entries[cellEnd].cellKey == cellKey)
+      cellEnd++;
+
+    for (size_t first = cellStart; first < cellEnd; first++)
+    {
+      const Bounds &bounds1 = proxies[entries[first].proxy];
+
+      for (size_t second = first + 1; second < cellEnd; second++)
+      {
+        const Bounds &bounds2 = proxies[entries[second].proxy];
+
+        if (bounds1.Overlaps(bounds2) == false)
+          continue;
+
+        // Overlapping bounds share every cell of their intersection: only report them in the one containing it's lowest corner
+        int64_t homeKey = MakeKey(GetCell(max(bounds1.min.x, bounds2.min.x)), GetCell(max(bounds1.min.y, bounds2.min.y)));
+
+        if (homeKey == cellKey)
+          pairs.emplace_back(entries[first].proxy, entries[second].proxy);
+      }
+    }
+  }
+}
+
+void SpatialHash::Query(const Bounds &bounds, vector<int> &proxies)
+{
+  int minX = GetCell(bounds.min.x), maxX = GetCell(bounds.max.x);
+  int minY = GetCell(bounds.min.y), maxY = GetCell(bounds.max.y);
+
+  // Looking up more cells than there are proxies costs more than testing them all
+  if ((int64_t)(maxX - minX + 1) * (maxY - minY + 1) > (int64_t)this->proxies.size())
+  {
+    for (int proxy = 0; proxy < (int)this->proxies.size(); proxy++)
+      if (used[proxy] && this->proxies[proxy].Overlaps(bounds))
+        proxies.push_back(proxy);
+
+    return;
+  }
+
+  size_t start = proxies.size();
+
+  for (int x = minX; x <= maxX; x++)
+    for (int y = minY; y <= maxY; y++)
+    {
+      // Entries are sorted by cell, then by proxy
+      int64_t cellKey = MakeKey(x, y);
+      auto entry = lower_bound(entries.begin(), entries.end(), cellKey, [](const Entry &entry, int64_t cellKey)
+                               { return entry.cellKey < cellKey; });
+
+      for (; entry != entries.end() && entry->cellKey == cellKey; entry++)
+        if (this->proxies[entry->proxy].Overlaps(bounds))
+          proxies.push_back(entry->proxy);
+    }
+
+  // Proxies spanning several of the cells were found in each
+  sort(proxies.begin() + start, proxies.end());
+  proxies.erase(unique(proxies.begin() + start, proxies.end()), proxies.end());
+}
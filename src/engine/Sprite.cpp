@@ -2,13 +2,31 @@
 #include "Resources.h"
 #include "Game.h"
 #include "Camera.h"
+#include "ComponentRegistry.h"
 #include <string>
 
 using namespace std;
 using namespace Helper;
 
+static shared_ptr<Component> RebuildSprite(GameObject &object, BinaryReader &reader)
+{
+  string path = reader.ReadString();
+  RenderLayer renderLayer = reader.Read<RenderLayer>();
+  int renderOrder = reader.Read<int>();
+  bool centered = reader.Read<bool>();
+
+  if (path.empty())
+    return object.AddComponent<Sprite>(renderLayer, renderOrder, centered);
+
+  return object.AddComponent<Sprite>(path, renderLayer, renderOrder, centered);
+}
+
+REGISTER_COMPONENT(Sprite, RebuildSprite)
+
 void Sprite::Load(const string fileName)
 {
+  path = fileName;
+
   // Get texture from resource manager
   texture = Resources::GetTexture(fileName);
 
@@ -39,13 +57,28 @@ void Sprite::Render(Vector2 position)
   SDL_Rect destinationRect{
       (int)offsetPosition.x, (int)offsetPosition.y, GetWidth(), GetHeight()};
 
-  // Put the texture in the renderer
-  SDL_RenderCopyEx(
-      Game::GetInstance().GetRenderer(),
-      texture.get(),
-      &clipRect,
-      &destinationRect,
-      Helper::RadiansToDegrees(gameObject.GetRotation()),
-      nullptr,
-      SDL_FLIP_NONE);
+  // Queue the texture in the sprite batch
+  Game::GetInstance().GetSpriteBatch().Draw(texture.get(), clipRect, destinationRect, gameObject.GetRotation());
+}
+
+void Sprite::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(path);
+  writer.Write(renderLayer);
+  writer.Write(renderOrder);
+  writer.Write(centered);
+}
+
+void Sprite::SaveState(BinaryWriter &writer)
+{
+  writer.Write(offset);
+  writer.Write(centered);
+  writer.Write(clipRect);
+}
+
+void Sprite::LoadState(BinaryReader &reader)
+{
+  offset = reader.ReadVector2();
+  centered = reader.Read<bool>();
+  clipRect = reader.Read<SDL_Rect>();
 }
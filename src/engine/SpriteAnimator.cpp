@@ -1,4 +1,19 @@
 #include "SpriteAnimator.h"
+#include "ComponentRegistry.h"
+
+using namespace std;
+
+static shared_ptr<Component> RebuildSpriteAnimator(GameObject &object, BinaryReader &reader)
+{
+  int spriteIndex = reader.Read<int>();
+  auto sprite = spriteIndex >= 0 ? dynamic_pointer_cast<Sprite>(object.GetComponentAt(spriteIndex)) : nullptr;
+  Vector2 frameDimensions = reader.ReadVector2();
+  float secondsPerFrame = reader.Read<float>();
+
+  return object.AddComponent<SpriteAnimator>(sprite, frameDimensions, secondsPerFrame);
+}
+
+REGISTER_COMPONENT(SpriteAnimator, RebuildSpriteAnimator)
 
 void SpriteAnimator::ConfigureSpriteFrames()
 {
@@ -31,27 +46,37 @@ void SpriteAnimator::Update(float deltaTime)
   if (frameElapsedTime < secondsPerFrame)
     return;
 
-  // If this is the cycle's last frame
-  if (currentFrame == GetFrameCount() - 1)
-  {
-    // Trigger event
-    OnCycleEnd.Invoke();
+  // Updates may come at a lowered rate, so advance as many frames as the elapsed time covers
+  int framesToAdvance = secondsPerFrame > 0 ? frameElapsedTime / secondsPerFrame : 1;
+  float remainingTime = frameElapsedTime - framesToAdvance * secondsPerFrame;
 
-    // Stop playing if not supposed to loop
-    if (loop == false)
+  for (int frame = 0; frame < framesToAdvance; frame++)
+  {
+    // If this is the cycle's last frame
+    if (currentFrame == GetFrameCount() - 1)
     {
-      playing = false;
-      return;
+      // Trigger event
+      OnCycleEnd.Invoke();
+
+      // Stop playing if not supposed to loop
+      if (loop == false)
+      {
+        playing = false;
+        return;
+      }
     }
+
+    // Advance frame
+    SetFrame(currentFrame + 1);
   }
 
-  // Advance frame
-  SetFrame(currentFrame + 1);
+  // Keep the time left over
+  frameElapsedTime = remainingTime;
 }
 
 void SpriteAnimator::SetFrame(int frameIndex)
 {
-  Assert(frameIndex >= 0, "Invalid frame index");
+  ASSERT(frameIndex >= 0, "Invalid frame index ", frameIndex);
 
   // Get sprite
   auto sprite = spriteWeak.lock();
@@ -84,3 +109,64 @@ void SpriteAnimator::SetFrame(int frameIndex)
       frameDimensions.x,
       frameDimensions.y);
 }
+
+void SpriteAnimator::DestroyObjectOnCycleEnd()
+{
+  destroyObjectOnCycleEnd = true;
+
+  if (destroyListener >= 0)
+    return;
+
+  // Get weak pointer to animation object
+  auto animationWeak = weak_ptr(gameObject.GetShared());
+
+  destroyListener = OnCycleEnd.AddListener([animationWeak]()
+                                           { if (auto animation = animationWeak.lock()) 
+                                              animation->RequestDestroy(); });
+}
+
+void SpriteAnimator::SaveConstruction(BinaryWriter &writer)
+{
+  auto sprite = spriteWeak.lock();
+
+  writer.Write(sprite ? gameObject.GetComponentIndex(sprite.get()) : -1);
+  writer.Write(frameDimensions);
+  writer.Write(secondsPerFrame);
+}
+
+void SpriteAnimator::SaveState(BinaryWriter &writer)
+{
+  writer.Write(loop);
+  writer.Write(destroyObjectOnCycleEnd);
+  writer.Write(playing);
+  writer.Write(currentFrame);
+  writer.Write(frameElapsedTime);
+}
+
+void SpriteAnimator::LoadState(BinaryReader &reader)
+{
+  loop = reader.Read<bool>();
+  destroyObjectOnCycleEnd = reader.Read<bool>();
+  playing = reader.Read<bool>();
+
+  // Setting the frame also resets the elapsed time
+  int frame = reader.Read<int>();
+
+  if (spriteWeak.expired() == false)
+    SetFrame(frame);
+
+  frameElapsedTime = reader.Read<float>();
+}
+
+void SpriteAnimator::OnRestore()
+{
+  if (destroyObjectOnCycleEnd)
+    DestroyObjectOnCycleEnd();
+
+  // It wasn't meant to be destroyed back then
+  else if (destroyListener >= 0)
+  {
+    OnCycleEnd.RemoveListener(destroyListener);
+    destroyListener = -1;
+  }
+}
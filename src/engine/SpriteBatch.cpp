@@ -0,0 +1,115 @@
+#include <cmath>
+#include <iostream>
+#include "SpriteBatch.h"
+#include "Game.h"
+
+using namespace std;
+
+bool SpriteBatch::reporting{false};
+
+void SpriteBatch::Counter::Add(const Counter &other)
+{
+  sprites += other.sprites;
+  drawCalls += other.drawCalls;
+}
+
+void SpriteBatch::SetReporting(bool reporting) { SpriteBatch::reporting = reporting; }
+
+void SpriteBatch::Draw(SDL_Texture *texture, const SDL_Rect &clip, const SDL_Rect &destination, float rotation)
+{
+  SDL_BlendMode blendMode;
+  SDL_GetTextureBlendMode(texture, &blendMode);
+
+  // Start a new batch if it can't join the queued one
+  if (texture != this->texture || blendMode != this->blendMode)
+  {
+    Flush();
+
+    int width, height;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+
+    this->texture = texture;
+    this->blendMode = blendMode;
+    textureWidth = width;
+    textureHeight = height;
+  }
+
+  // Texture coordinates of the clip
+  float left = clip.x / textureWidth, right = (clip.x + clip.w) / textureWidth;
+  float top = clip.y / textureHeight, bottom = (clip.y + clip.h) / textureHeight;
+
+  // Rotate the corners around the center (clockwise, as the y axis points down)
+  float halfWidth = destination.w / 2.0f, halfHeight = destination.h / 2.0f;
+  float centerX = destination.x + halfWidth, centerY = destination.y + halfHeight;
+  float cosine = 1, sine = 0;
+
+  if (rotation != 0)
+  {
+    cosine = cos(rotation);
+    sine = sin(rotation);
+  }
+
+  auto AddCorner = [&](float x, float y, float u, float v)
+  {
+    vertices.push_back(SDL_Vertex{
+        SDL_FPoint{centerX + x * cosine - y * sine, centerY + x * sine + y * cosine},
+        SDL_Color{255, 255, 255, 255},
+        SDL_FPoint{u, v}});
+  };
+
+  AddCorner(-halfWidth, -halfHeight, left, top);
+  AddCorner(halfWidth, -halfHeight, right, top);
+  AddCorner(halfWidth, halfHeight, right, bottom);
+  AddCorner(-halfWidth, halfHeight, left, bottom);
+
+  // Make sure there are triangles for this quad
+  int quad = vertices.size() / 4 - 1;
+
+  if ((int)indices.size() / 6 <= quad)
+  {
+    int first = quad * 4;
+
+    indices.insert(indices.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+  }
+
+  frame.sprites++;
+}
+
+void SpriteBatch::Flush()
+{
+  if (vertices.empty())
+    return;
+
+  SDL_RenderGeometry(Game::GetInstance().GetRenderer(), texture, vertices.data(), vertices.size(),
+                     indices.data(), vertices.size() / 4 * 6);
+
+  vertices.clear();
+  frame.drawCalls++;
+}
+
+void SpriteBatch::EndFrame()
+{
+  Flush();
+
+  // Textures may be destroyed before the next frame
+  texture = nullptr;
+
+  total.Add(frame);
+  lastFrame = frame;
+  frame = Counter{};
+  frames++;
+}
+
+void SpriteBatch::Report() const
+{
+  if (reporting == false || frames == 0 || total.drawCalls == 0)
+    return;
+
+  auto PerFrame = [this](size_t value)
+  { return (float)value / frames; };
+
+  cout << "Render report: " << frames << " frames" << endl
+       << "  sprites: " << PerFrame(total.sprites) << " per frame" << endl
+       << "  draw calls: " << PerFrame(total.drawCalls) << " per frame ("
+       << (float)total.sprites / total.drawCalls << " sprites per call)" << endl;
+}
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include "SweepAndPrune.h"
+#include "Helper.h"
+
+using namespace std;
+
+int64_t SweepAndPrune::MakeKey(int proxy1, int proxy2)
+{
+  auto [low, high] = minmax(proxy1, proxy2);
+
+  return ((int64_t)low << 32) | (uint32_t)high;
+}
+
+static pair<int, int> SplitKey(int64_t key) { return {(int)(key >> 32), (int)(uint32_t)key}; }
+
+int SweepAndPrune::CreateProxy(const Bounds &bounds)
+{
+  int proxy;
+
+  if (freeProxies.empty())
+  {
+    proxy = proxies.size();
+    proxies.push_back(bounds);
+    used.push_back(true);
+  }
+  else
+  {
+    proxy = freeProxies.back();
+    freeProxies.pop_back();
+    proxies[proxy] = bounds;
+    used[proxy] = true;
+  }
+
+  // Add it's ends past all others: sorting them into place finds every pair it's in
+  for (auto &axis : endpoints)
+  {
+    axis.push_back(Endpoint{0, proxy, false});
+    axis.push_back(Endpoint{0, proxy, true});
+  }
+
+  createdCount++;
+
+  return proxy;
+}
+
+void SweepAndPrune::MoveProxy(int proxy, const Bounds &bounds) { proxies[proxy] = bounds; }
+
+void SweepAndPrune::DestroyProxy(int proxy)
+{
+  ASSERT(proxy >= 0 && proxy < (int)proxies.size() && used[proxy], "Invalid sweep and prune proxy ", proxy);
+
+  used[proxy] = false;
+  freeProxies.push_back(proxy);
+
+  for (auto &axis : endpoints)
+    axis.erase(remove_if(axis.begin(), axis.end(), [proxy](const Endpoint &endpoint)
+                         { return endpoint.proxy == proxy; }),
+               axis.end());
+
+  // Drop it's pairs
+  auto isLost = [proxy](int64_t key)
+  { auto [proxy1, proxy2] = SplitKey(key); return proxy1 == proxy || proxy2 == proxy; };
+
+  copy_if(pairKeys.begin(), pairKeys.end(), back_inserter(destroyedKeys), isLost);
+  pairKeys.erase(remove_if(pairKeys.begin(), pairKeys.end(), isLost), pairKeys.end());
+}
+
+void SweepAndPrune::RefreshAxis(int axis)
+{
+  for (auto &endpoint : endpoints[axis])
+  {
+    const Bounds &bounds = proxies[endpoint.proxy];
+    endpoint.value = endpoint.isMax ? (axis == 0 ? bounds.max.x : bounds.max.y) : (axis == 0 ? bounds.min.x : bounds.min.y);
+  }
+}
+
+void SweepAndPrune::SortAxis(int axis)
+{
+  auto &axisEndpoints = endpoints[axis];
+
+  // Insertion sort, which is about linear on nearly sorted ends
+  for (size_t index = 1; index < axisEndpoints.size(); index++)
+  {
+    Endpoint endpoint = axisEndpoints[index];
+    size_t position = index;
+
+    while (position > 0 && Before(endpoint, axisEndpoints[position - 1]))
+    {
+      const Endpoint &other = axisEndpoints[position - 1];
+
+      if (endpoint.proxy != other.proxy)
+      {
+        // A start moving before an end: they now overlap along this axis, so they may overlap
+        if (endpoint.isMax == false && other.isMax)
+        {
+          if (proxies[endpoint.proxy].Overlaps(proxies[other.proxy]))
+            addedKeys.push_back(MakeKey(endpoint.proxy, other.proxy));
+        }
+
+        // An end moving before a start: they no longer overlap
+        else if (endpoint.isMax && other.isMax == false)
+          removedKeys.push_back(MakeKey(endpoint.proxy, other.proxy));
+      }
+
+      axisEndpoints[position] = other;
+      position--;
+      swapCount++;
+    }
+
+    axisEndpoints[position] = endpoint;
+  }
+}
+
+void SweepAndPrune::Rebuild()
+{
+  for (auto &axis : endpoints)
+    sort(axis.begin(), axis.end(), Before);
+
+  // Sweep along x, keeping track of the proxies whose interval is open
+  mergeBuffer.clear();
+  sweepActive.clear();
+
+  for (auto &endpoint : endpoints[0])
+  {
+    if (endpoint.isMax)
+    {
+      sweepActive.erase(find(sweepActive.begin(), sweepActive.end(), endpoint.proxy));
+      continue;
+    }
+
+    for (int other : sweepActive)
+      if (proxies[endpoint.proxy].Overlaps(proxies[other]))
+        mergeBuffer.push_back(MakeKey(endpoint.proxy, other));
+
+    sweepActive.push_back(endpoint.proxy);
+  }
+
+  sort(mergeBuffer.begin(), mergeBuffer.end());
+
+  // Compare with the previous pairs
+  set_difference(mergeBuffer.begin(), mergeBuffer.end(), pairKeys.begin(), pairKeys.end(), back_inserter(addedKeys));
+  set_difference(pairKeys.begin(), pairKeys.end(), mergeBuffer.begin(), mergeBuffer.end(), back_inserter(removedKeys));
+}
+
+void SweepAndPrune::FindPairs(vector<pair<int, int>> &pairs)
+{
+  addedKeys.clear();
+  removedKeys.clear();
+  swapCount = 0;
+
+  RefreshAxis(0);
+  RefreshAxis(1);
+
+  maxWidth = 0;
+
+  for (int proxy = 0; proxy < (int)proxies.size(); proxy++)
+    if (used[proxy])
+      maxWidth = max(maxWidth, proxies[proxy].max.x - proxies[proxy].min.x);
+
+  // Sorting new ends in one by one takes quadratic time, so many of them are better sorted from scratch
+  if (createdCount > 16 && createdCount * 8 > (int)endpoints[0].size())
+    Rebuild();
+  else
+  {
+    SortAxis(0);
+    SortAxis(1);
+  }
+
+  createdCount = 0;
+
+  // The same change may be seen along both axes
+  sort(addedKeys.begin(), addedKeys.end());
+  addedKeys.erase(unique(addedKeys.begin(), addedKeys.end()), addedKeys.end());
+
+  sort(removedKeys.begin(), removedKeys.end());
+  removedKeys.erase(unique(removedKeys.begin(), removedKeys.end()), removedKeys.end());
+
+  // Pairs separating along one axis may not have been overlapping along the other
+  removedKeys.erase(remove_if(removedKeys.begin(), removedKeys.end(), [this](int64_t key)
+                              { return binary_search(pairKeys.begin(), pairKeys.end(), key) == false; }),
+                    removedKeys.end());
+
+  // Apply the changes
+  mergeBuffer.clear();
+  set_difference(pairKeys.begin(), pairKeys.end(), removedKeys.begin(), removedKeys.end(), back_inserter(mergeBuffer));
+
+  pairKeys.clear();
+  set_union(mergeBuffer.begin(), mergeBuffer.end(), addedKeys.begin(), addedKeys.end(), back_inserter(pairKeys));
+
+  // Report them
+  pairs.clear();
+
+  for (int64_t key : pairKeys)
+    pairs.push_back(SplitKey(key));
+
+  addedPairs.clear();
+
+  for (int64_t key : addedKeys)
+    addedPairs.push_back(SplitKey(key));
+
+  removedPairs.clear();
+
+  for (int64_t key : destroyedKeys)
+    removedPairs.push_back(SplitKey(key));
+
+  for (int64_t key : removedKeys)
+    removedPairs.push_back(SplitKey(key));
+
+  destroyedKeys.clear();
+}
+
+void SweepAndPrune::Query(const Bounds &bounds, vector<int> &proxies)
+{
+  // Ends of proxies created since the search aren't sorted yet
+  if (createdCount > 0)
+  {
+    for (int proxy = 0; proxy < (int)this->proxies.size(); proxy++)
+      if (used[proxy] && this->proxies[proxy].Overlaps(bounds))
+        proxies.push_back(proxy);
+
+    return;
+  }
+
+  // Proxies overlapping it along x start within the widest width before it
+  auto &axis = endpoints[0];
+  auto endpoint = lower_bound(axis.begin(), axis.end(), bounds.min.x - maxWidth, [](const Endpoint &endpoint, float value)
+                              { return endpoint.value < value; });
+
+  for (; endpoint != axis.end() && endpoint->value <= bounds.max.x; endpoint++)
+    if (endpoint->isMax == false && this->proxies[endpoint->proxy].Overlaps(bounds))
+      proxies.push_back(endpoint->proxy);
+}
@@ -1,9 +1,22 @@
 #include "Text.h"
 #include "Resources.h"
 #include "Camera.h"
+#include "ComponentRegistry.h"
 
 using namespace std;
 
+static shared_ptr<Component> RebuildText(GameObject &object, BinaryReader &reader)
+{
+  string text = reader.ReadString();
+  string fontPath = reader.ReadString();
+  int fontSize = reader.Read<int>();
+  Text::Style style = reader.Read<Text::Style>();
+
+  return object.AddComponent<Text>(text, fontPath, fontSize, style, reader.ReadColor());
+}
+
+REGISTER_COMPONENT(Text, RebuildText)
+
 Text::Text(
     GameObject &associatedObject, string text, string fontPath,
     int size, Style style, Color color)
@@ -28,15 +41,8 @@ void Text::Render()
   // Get destination rectangle
   SDL_Rect destinationRect{(int)offsetPosition.x, (int)offsetPosition.y, width, height};
 
-  // Put the texture in the renderer
-  SDL_RenderCopyEx(
-      Game::GetInstance().GetRenderer(),
-      texture.get(),
-      &clipRect,
-      &destinationRect,
-      Helper::RadiansToDegrees(gameObject.GetRotation()),
-      nullptr,
-      SDL_FLIP_NONE);
+  // Queue the texture in the sprite batch
+  Game::GetInstance().GetSpriteBatch().Draw(texture.get(), clipRect, destinationRect, gameObject.GetRotation());
 }
 
 void Text::SetText(string text)
@@ -77,7 +83,7 @@ void Text::RemakeTexture()
     surface.reset(TTF_RenderText_Blended(font.get(), text.c_str(), color));
 
   // Ensure it's loaded
-  Assert(surface != nullptr, "Failed to generate surface from font");
+  CHECK(surface != nullptr, "Failed to generate surface from font. Reported error: ", TTF_GetError());
 
   // Get the dimensions
   width = surface->w;
@@ -87,3 +93,23 @@ void Text::RemakeTexture()
   texture.reset(
       SDL_CreateTextureFromSurface(Game::GetInstance().GetRenderer(), surface.get()));
 }
+
+void Text::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(text);
+  writer.Write(fontPath);
+  writer.Write(fontSize);
+  writer.Write(style);
+  writer.Write(color);
+}
+
+void Text::SaveState(BinaryWriter &writer) { writer.Write(text); }
+
+void Text::LoadState(BinaryReader &reader)
+{
+  string savedText = reader.ReadString();
+
+  // Only remake the texture if it changed
+  if (savedText != text)
+    SetText(savedText);
+}
@@ -0,0 +1,108 @@
+#include <cmath>
+#include "TileCollisionGrid.h"
+#include "TileMap.h"
+
+using namespace std;
+
+void TileCollisionGrid::Build(const TileMap &tileMap, int layer, const vector<bool> &solidTiles, bool outsideSolid)
+{
+  ASSERT(layer >= 0 && layer < tileMap.GetDepth(), "Tilemap has no layer ", layer);
+
+  columns = tileMap.HorizontalTileCount();
+  rows = tileMap.VerticalTileCount();
+  cellSize = Vector2(tileMap.GetWidth() / columns, tileMap.GetHeight() / rows);
+  origin = tileMap.gameObject.GetPosition() - Vector2(tileMap.GetWidth(), tileMap.GetHeight()) / 2;
+  this->outsideSolid = outsideSolid;
+
+  solid.resize(columns * rows);
+
+  for (int row = 0; row < rows; row++)
+    for (int column = 0; column < columns; column++)
+    {
+      int tile = tileMap.At(column, row, layer);
+
+      solid[column + row * columns] = tile >= 0 && tile < (int)solidTiles.size() && solidTiles[tile];
+    }
+}
+
+int TileCollisionGrid::GetColumn(float x) const { return floor((x - origin.x) / cellSize.x); }
+
+int TileCollisionGrid::GetRow(float y) const { return floor((y - origin.y) / cellSize.y); }
+
+bool TileCollisionGrid::IsSolid(int column, int row) const
+{
+  if (column < 0 || row < 0 || column >= columns || row >= rows)
+    return outsideSolid;
+
+  return solid[column + row * columns];
+}
+
+bool TileCollisionGrid::Overlaps(const Bounds &bounds) const
+{
+  // Cells touched by the bounds' interior (bounds ending exactly on a cell's side don't enter it)
+  int firstColumn = GetColumn(bounds.min.x), lastColumn = ceil((bounds.max.x - origin.x) / cellSize.x) - 1;
+  int firstRow = GetRow(bounds.min.y), lastRow = ceil((bounds.max.y - origin.y) / cellSize.y) - 1;
+
+  for (int row = firstRow; row <= lastRow; row++)
+    for (int column = firstColumn; column <= lastColumn; column++)
+      if (IsSolid(column, row))
+        return true;
+
+  return false;
+}
+
+float TileCollisionGrid::SweepAxis(const Bounds &bounds, float distance, int axis) const
+{
+  if (distance == 0)
+    return 0;
+
+  float min[2]{bounds.min.x, bounds.min.y}, max[2]{bounds.max.x, bounds.max.y};
+  float origins[2]{origin.x, origin.y}, sizes[2]{cellSize.x, cellSize.y};
+  int other = 1 - axis;
+
+  // Cells the bounds span across the motion
+  int firstAcross = floor((min[other] - origins[other]) / sizes[other]);
+  int lastAcross = ceil((max[other] - origins[other]) / sizes[other]) - 1;
+
+  auto IsSolidLine = [this, axis, firstAcross, lastAcross](int along)
+  {
+    for (int across = firstAcross; across <= lastAcross; across++)
+      if (axis == 0 ? IsSolid(along, across) : IsSolid(across, along))
+        return true;
+
+    return false;
+  };
+
+  // Go through the lines of cells the leading side enters, in order
+  if (distance > 0)
+  {
+    int first = ceil((max[axis] - origins[axis]) / sizes[axis]);
+    int last = ceil((max[axis] + distance - origins[axis]) / sizes[axis]) - 1;
+
+    for (int along = first; along <= last; along++)
+      if (IsSolidLine(along))
+        return std::max(origins[axis] + along * sizes[axis] - max[axis], 0.0f);
+  }
+  else
+  {
+    int first = floor((min[axis] - origins[axis]) / sizes[axis]) - 1;
+    int last = floor((min[axis] + distance - origins[axis]) / sizes[axis]);
+
+    for (int along = first; along >= last; along--)
+      if (IsSolidLine(along))
+        return std::min(origins[axis] + (along + 1) * sizes[axis] - min[axis], 0.0f);
+  }
+
+  return distance;
+}
+
+Vector2 TileCollisionGrid::Resolve(const Bounds &bounds, Vector2 motion) const
+{
+  if (IsBuilt() == false)
+    return motion;
+
+  motion.x = SweepAxis(bounds, motion.x, 0);
+  motion.y = SweepAxis(Bounds(bounds.min + Vector2(motion.x, 0), bounds.max + Vector2(motion.x, 0)), motion.y, 1);
+
+  return motion;
+}
@@ -4,10 +4,26 @@
 #include "TileMap.h"
 #include "Helper.h"
 #include "Camera.h"
+#include "ComponentRegistry.h"
 
 using namespace std;
 using namespace Helper;
 
+static shared_ptr<Component> RebuildTileMap(GameObject &object, BinaryReader &reader)
+{
+  int targetLayer = reader.Read<int>();
+  RenderLayer renderLayer = reader.Read<RenderLayer>();
+  int width = reader.Read<int>(), height = reader.Read<int>(), depth = reader.Read<int>();
+
+  vector<int> tiles(width * height * depth);
+  reader.ReadArray(tiles.data(), tiles.size());
+
+  // The tileset is found on restore
+  return object.AddComponent<TileMap>(width, height, depth, move(tiles), nullptr, targetLayer, renderLayer);
+}
+
+REGISTER_COMPONENT(TileMap, RebuildTileMap)
+
 TileMap::TileMap(
     GameObject &associatedObject, std::string filename,
     shared_ptr<TileSet> tileSet, int onlyLayer, RenderLayer renderLayer)
@@ -16,7 +32,17 @@ TileMap::TileMap(
   Load(filename);
 
   // Validate target layer
-  Assert(targetLayer < mapDepth, "Target layer must not exceed the depth of the tilemap file configuration");
+  CHECK(targetLayer < mapDepth, "Target layer must not exceed the depth of the tilemap file configuration");
+}
+
+TileMap::TileMap(
+    GameObject &associatedObject, int width, int height, int depth, vector<int> tiles,
+    shared_ptr<TileSet> tileSet, int onlyLayer, RenderLayer renderLayer)
+    : Component(associatedObject), tileMatrix(move(tiles)), tileSet(tileSet), mapWidth(width), mapHeight(height), mapDepth(depth),
+      renderLayer(renderLayer), targetLayer(onlyLayer)
+{
+  ASSERT((int)tileMatrix.size() == mapWidth * mapHeight * mapDepth, "Tile count doesn't match the tilemap dimensions");
+  ASSERT(targetLayer < mapDepth, "Target layer must not exceed the depth of the tilemap");
 }
 
 void TileMap::Load(std::string filename)
@@ -28,7 +54,7 @@ void TileMap::Load(std::string filename)
   ifstream mapFile(filename.c_str());
 
   // Ensure all's good
-  Assert(mapFile.is_open(), "Unable to open tilemap configuration file " + filename);
+  CHECK(mapFile.is_open(), "Unable to open tilemap configuration file ", filename);
 
   // Will hold each line from the document
   string line;
@@ -127,3 +153,57 @@ void TileMap::Render()
 
 float TileMap::GetWidth() const { return HorizontalTileCount() * tileSet->GetTileWidth(); }
 float TileMap::GetHeight() const { return VerticalTileCount() * tileSet->GetTileHeight(); }
+
+void TileMap::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(targetLayer);
+  writer.Write(renderLayer);
+  writer.Write(mapWidth);
+  writer.Write(mapHeight);
+  writer.Write(mapDepth);
+  writer.WriteArray(tileMatrix.data(), tileMatrix.size());
+}
+
+void TileMap::SaveState(BinaryWriter &writer)
+{
+  auto tileSetObject = tileSet ? tileSet->GetObject() : nullptr;
+
+  writer.Write(tileSetObject ? tileSetObject->id : -1);
+  writer.Write(Vector2(tileSet ? tileSet->GetTileWidth() : 0, tileSet ? tileSet->GetTileHeight() : 0));
+}
+
+void TileMap::LoadState(BinaryReader &reader)
+{
+  restoredTileSetId = reader.Read<int>();
+  restoredTileSize = reader.ReadVector2();
+}
+
+void TileMap::OnRestore()
+{
+  auto tileSetObject = tileSet ? tileSet->GetObject() : nullptr;
+
+  // Keep it if it's object wasn't rebuilt
+  if ((tileSetObject ? tileSetObject->id : -1) == restoredTileSetId && (restoredTileSetId < 0 || tileSetObject != nullptr))
+    return;
+
+  tileSet.reset();
+
+  auto restoredObject = restoredTileSetId >= 0 ? gameState.GetObject(restoredTileSetId) : nullptr;
+
+  if (!restoredObject)
+    return;
+
+  // Share it with the other layers of this map, if they already found it
+  for (int index = 0; index < gameObject.GetComponentCount(); index++)
+  {
+    auto otherMap = dynamic_pointer_cast<TileMap>(gameObject.GetComponentAt(index));
+
+    if (otherMap && otherMap->tileSet && otherMap->tileSet->GetObject() == restoredObject)
+    {
+      tileSet = otherMap->tileSet;
+      return;
+    }
+  }
+
+  tileSet = make_shared<TileSet>(restoredTileSize.x, restoredTileSize.y, restoredObject);
+}
@@ -7,27 +7,35 @@
 using namespace std;
 using namespace Helper;
 
-TileSet::TileSet(int tileWidth, int tileHeight, std::string filename) : tileWidth(tileWidth), tileHeight(tileHeight)
-{
-  // Create tileset object
-  auto object = Game::GetInstance().GetState().CreateObject("Tileset");
-  objectWeak = object;
+TileSet::TileSet(int tileWidth, int tileHeight, std::string filename) : TileSet(tileWidth, tileHeight, CreateObject(filename)) {}
 
-  // Add the sprite component
-  // Don't give it a render layer. It must only be directly rendered by the tilemap method
-  auto tileSprite = object->AddComponent<Sprite>(filename, RenderLayer::None);
+TileSet::TileSet(int tileWidth, int tileHeight, shared_ptr<GameObject> object) : tileWidth(tileWidth), tileHeight(tileHeight), objectWeak(object)
+{
+  auto tileSprite = object->RequireComponent<Sprite>();
 
   tileSpriteWeak = tileSprite;
 
   // Avoid awkward situations
-  Assert(tileWidth > 0 && tileHeight > 0, "Tile dimensions must be greater than zero");
-  Assert(tileSprite->GetUnscaledHeight() > 0 && tileSprite->GetUnscaledWidth() > 0, "Tileset sprite is invalid (dimensions not greater than 0)");
+  CHECK(tileWidth > 0 && tileHeight > 0, "Tile dimensions must be greater than zero");
+  CHECK(tileSprite->GetUnscaledHeight() > 0 && tileSprite->GetUnscaledWidth() > 0, "Tileset sprite is invalid (dimensions not greater than 0)");
 
   // Get the rows & columns
   rows = tileSprite->GetUnscaledHeight() / tileHeight;
   columns = tileSprite->GetUnscaledWidth() / tileWidth;
 }
 
+shared_ptr<GameObject> TileSet::CreateObject(string filename)
+{
+  // Create tileset object
+  auto object = Game::GetInstance().GetState().CreateObject("Tileset");
+
+  // Add the sprite component
+  // Don't give it a render layer. It must only be directly rendered by the tilemap method
+  object->AddComponent<Sprite>(filename, RenderLayer::None);
+
+  return object;
+}
+
 TileSet::~TileSet()
 {
   if (objectWeak.expired())
@@ -40,11 +48,11 @@ TileSet::~TileSet()
 void TileSet::RenderTile(unsigned index, Vector2 position)
 {
   // Ensure valid index
-  Assert((int)index < rows * columns, "Invalid index");
+  ASSERT((int)index < rows * columns, "Invalid tile index ", index);
 
   auto tileSprite = tileSpriteWeak.lock();
 
-  Assert((bool)tileSprite, "Failed to retrieve tileset sprite");
+  ASSERT((bool)tileSprite, "Failed to retrieve tileset sprite");
 
   // Get to which row this tile belongs
   int tileRow = index / columns;
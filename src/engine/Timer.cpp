@@ -0,0 +1,154 @@
+#include "Timer.h"
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+vector<string> &Timer::GetNames()
+{
+  static vector<string> names;
+  return names;
+}
+
+TimerId Timer::Intern(const string &name)
+{
+  static unordered_map<string, int> registry;
+
+  // Give it the next id if it's new
+  auto [entry, inserted] = registry.try_emplace(name, (int)registry.size());
+
+  if (inserted)
+    GetNames().push_back(name);
+
+  return TimerId{entry->second};
+}
+
+const string &Timer::GetName(TimerId id) { return GetNames()[id.value]; }
+
+Timer::Entry &Timer::GetEntry(TimerId id)
+{
+  for (auto &entry : entries)
+    if (entry.id.value == id.value)
+      return entry;
+
+  entries.push_back(Entry{id});
+
+  return entries.back();
+}
+
+void Timer::Reset(TimerId id, float value, bool enable)
+{
+  auto &entry = GetEntry(id);
+
+  entry.value = value;
+  entry.enabled = enable;
+  entry.startTime = wheel.GetTime();
+}
+
+float Timer::Get(TimerId id) const
+{
+  for (auto &entry : entries)
+    if (entry.id.value == id.value)
+      return entry.enabled ? entry.value + (float)(wheel.GetTime() - entry.startTime) : entry.value;
+
+  return 0.0f;
+}
+
+void Timer::Start(TimerId id)
+{
+  auto &entry = GetEntry(id);
+
+  if (entry.enabled)
+    return;
+
+  entry.enabled = true;
+  entry.startTime = wheel.GetTime();
+}
+
+void Timer::Stop(TimerId id)
+{
+  auto &entry = GetEntry(id);
+
+  if (entry.enabled == false)
+    return;
+
+  // Bank the elapsed time
+  entry.value = Get(id);
+  entry.enabled = false;
+}
+
+TimerHandle Timer::After(float seconds, Delegate<void()> callback)
+{
+  return Track(wheel.Schedule(seconds, move(callback)));
+}
+
+TimerHandle Timer::Every(float seconds, Delegate<void()> callback)
+{
+  return Track(wheel.Schedule(seconds, move(callback), seconds));
+}
+
+TimerHandle Timer::Track(TimerHandle handle)
+{
+  // Forget callbacks which already fired or were cancelled
+  scheduled.erase(
+      remove_if(scheduled.begin(), scheduled.end(), [this](TimerHandle other)
+                { return wheel.IsScheduled(other) == false; }),
+      scheduled.end());
+
+  scheduled.push_back(handle);
+
+  return handle;
+}
+
+void Timer::CancelAll()
+{
+  for (auto handle : scheduled)
+    wheel.Cancel(handle);
+
+  scheduled.clear();
+}
+
+void Timer::SaveState(BinaryWriter &writer, bool withCallbacks) const
+{
+  writer.Write<uint32_t>(entries.size());
+
+  for (auto &entry : entries)
+  {
+    if (withCallbacks)
+      writer.Write(entry.id);
+    else
+      writer.Write(GetName(entry.id));
+
+    writer.Write(Get(entry.id));
+    writer.Write(entry.enabled);
+  }
+
+  if (withCallbacks == false)
+  {
+    writer.Write<uint32_t>(0);
+    return;
+  }
+
+  writer.Write<uint32_t>(scheduled.size());
+
+  for (auto handle : scheduled)
+    writer.Write(handle);
+}
+
+void Timer::LoadState(BinaryReader &reader, bool withCallbacks)
+{
+  entries.resize(reader.Read<uint32_t>());
+
+  for (auto &entry : entries)
+  {
+    entry.id = withCallbacks ? reader.Read<TimerId>() : Intern(reader.ReadString());
+    entry.value = reader.Read<float>();
+    entry.enabled = reader.Read<bool>();
+    entry.startTime = wheel.GetTime();
+  }
+
+  scheduled.resize(reader.Read<uint32_t>());
+
+  for (auto &handle : scheduled)
+    handle = reader.Read<TimerHandle>();
+}
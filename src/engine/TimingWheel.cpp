@@ -0,0 +1,252 @@
+#include "TimingWheel.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Duration of a wheel tick, in seconds
+const double TimingWheel::tickDuration{1.0 / 240.0};
+
+TimingWheel::TimingWheel() : heads(levelCount * slotCount + 1, -1)
+{
+  entries.reserve(64);
+  freeEntries.reserve(64);
+}
+
+uint64_t TimingWheel::ToTicks(float seconds)
+{
+  return max<uint64_t>(1, (uint64_t)ceil(max(0.0f, seconds) / tickDuration));
+}
+
+TimerHandle TimingWheel::Schedule(float seconds, Delegate<void()> callback, float period, bool transient)
+{
+  int index = Allocate();
+  Entry &entry = entries[index];
+
+  entry.callback = move(callback);
+  entry.transient = transient;
+  entry.deadline = currentTick + ToTicks(seconds);
+  entry.period = period > 0.0f ? ToTicks(period) : 0;
+
+  Insert(index);
+
+  return TimerHandle{index, entry.generation};
+}
+
+void TimingWheel::Cancel(TimerHandle handle)
+{
+  if (IsScheduled(handle) == false)
+    return;
+
+  // It may be firing right now, in which case it's in no list
+  if (entries[handle.index].list != noList)
+    Unlink(handle.index);
+
+  Release(handle.index);
+}
+
+bool TimingWheel::IsScheduled(TimerHandle handle) const
+{
+  return handle.index >= 0 && handle.index < (int)entries.size() && handle.generation != 0 &&
+         entries[handle.index].generation == handle.generation;
+}
+
+void TimingWheel::Restore(const TimingWheel &copy)
+{
+  uint32_t generation = max(nextGeneration, copy.nextGeneration);
+
+  *this = copy;
+
+  nextGeneration = generation;
+
+  for (int index = 0; index < (int)entries.size(); index++)
+    if (entries[index].generation != 0 && entries[index].transient)
+      Cancel(TimerHandle{index, entries[index].generation});
+}
+
+void TimingWheel::Clear()
+{
+  for (int index = 0; index < (int)entries.size(); index++)
+    if (entries[index].generation != 0)
+      Cancel(TimerHandle{index, entries[index].generation});
+}
+
+void TimingWheel::Advance(float deltaTime)
+{
+  time += deltaTime;
+
+  uint64_t targetTick = (uint64_t)(time / tickDuration);
+
+  while (currentTick < targetTick)
+  {
+    // Nothing to fire, so simply jump to the target
+    if (scheduledCount == 0)
+    {
+      currentTick = targetTick;
+      return;
+    }
+
+    currentTick++;
+
+    // Bring down entries from coarser levels whose block starts now (coarsest first, so they can keep cascading)
+    for (int level = levelCount - 1; level > 0; level--)
+      if ((currentTick & ((1ull << (slotBits * level)) - 1)) == 0)
+        Cascade(level);
+
+    FireDue();
+  }
+}
+
+void TimingWheel::Insert(int index)
+{
+  Entry &entry = entries[index];
+
+  // Ticks until deadline (an overdue entry goes to the slot about to fire)
+  uint64_t delta = entry.deadline > currentTick ? entry.deadline - currentTick : 0;
+
+  // Find the finest level whose range covers the deadline
+  for (int level = 0; level < levelCount; level++)
+  {
+    if (delta < (1ull << (slotBits * (level + 1))))
+    {
+      uint64_t tick = max(entry.deadline, currentTick);
+      int slot = (tick >> (slotBits * level)) & (slotCount - 1);
+
+      Link(index, level * slotCount + slot);
+      return;
+    }
+  }
+
+  // Too far away: park it in the coarsest slot that will be cascaded last, where it will be reinserted
+  int level = levelCount - 1;
+  int slot = ((currentTick >> (slotBits * level)) + slotCount - 1) & (slotCount - 1);
+
+  Link(index, level * slotCount + slot);
+}
+
+void TimingWheel::Link(int index, int list)
+{
+  Entry &entry = entries[index];
+
+  entry.list = list;
+  entry.previous = -1;
+  entry.next = heads[list];
+
+  if (entry.next != -1)
+    entries[entry.next].previous = index;
+
+  heads[list] = index;
+}
+
+void TimingWheel::Unlink(int index)
+{
+  Entry &entry = entries[index];
+
+  if (entry.previous != -1)
+    entries[entry.previous].next = entry.next;
+  else
+    heads[entry.list] = entry.next;
+
+  if (entry.next != -1)
+    entries[entry.next].previous = entry.previous;
+
+  entry.list = noList;
+  entry.previous = entry.next = -1;
+}
+
+void TimingWheel::Cascade(int level)
+{
+  int list = level * slotCount + ((currentTick >> (slotBits * level)) & (slotCount - 1));
+
+  // Detach the whole slot, then reinsert each of it's entries
+  int index = heads[list];
+  heads[list] = -1;
+
+  while (index != -1)
+  {
+    int next = entries[index].next;
+
+    entries[index].list = noList;
+    Insert(index);
+
+    index = next;
+  }
+}
+
+void TimingWheel::FireDue()
+{
+  int list = currentTick & (slotCount - 1);
+
+  // Move the slot to the due list, so that callbacks may freely schedule into the wheel
+  heads[dueList] = heads[list];
+  heads[list] = -1;
+
+  for (int index = heads[dueList]; index != -1; index = entries[index].next)
+    entries[index].list = dueList;
+
+  while (heads[dueList] != -1)
+  {
+    int index = heads[dueList];
+    Unlink(index);
+
+    Entry &entry = entries[index];
+
+    // Take the callback out, as the entry pool may grow while it runs
+    auto callback = move(entry.callback);
+    uint32_t generation = entry.generation;
+    bool periodic = entry.period > 0;
+
+    // One shot entries are done
+    if (periodic == false)
+      Release(index);
+
+    callback();
+
+    // Reschedule periodic entries, unless cancelled by the callback
+    if (periodic && entries[index].generation == generation)
+    {
+      entries[index].callback = move(callback);
+      entries[index].deadline = currentTick + entries[index].period;
+      Insert(index);
+    }
+  }
+}
+
+int TimingWheel::Allocate()
+{
+  scheduledCount++;
+
+  int index;
+
+  if (freeEntries.empty())
+  {
+    entries.emplace_back();
+    index = entries.size() - 1;
+  }
+  else
+  {
+    index = freeEntries.back();
+    freeEntries.pop_back();
+  }
+
+  entries[index].generation = nextGeneration++;
+
+  // Zero marks free entries
+  if (nextGeneration == 0)
+    nextGeneration = 1;
+
+  return index;
+}
+
+void TimingWheel::Release(int index)
+{
+  scheduledCount--;
+
+  Entry &entry = entries[index];
+
+  entry.callback.Reset();
+  entry.generation = 0;
+  entry.list = noList;
+
+  freeEntries.push_back(index);
+}
@@ -0,0 +1,108 @@
+#include "UpdateScheduler.h"
+#include <algorithm>
+
+using namespace std;
+
+// Distances from the camera view past which the rate halves, quarters and drops to an eighth
+const float UpdateScheduler::rateDistances[3]{256.0f, 768.0f, 1536.0f};
+
+// How many lowered rate updates may run in a single frame
+const int UpdateScheduler::maxReducedUpdatesPerFrame{128};
+
+// Most frames past due that are told apart when giving priority
+const int UpdateScheduler::maxOverdueFrames{63};
+
+UpdateScheduler::UpdateScheduler() : priorityOverdue(maxOverdueFrames + 1), postponedOverdue(maxOverdueFrames + 1, 0) {}
+
+void UpdateScheduler::BeginFrame(Vector2 viewTopLeft, Vector2 viewSize)
+{
+  lastFrameStats = frameStats;
+  frameStats = UpdateStats();
+
+  // Last frame's postponed components are due again, a frame later: keep slots for as many of them as fit,
+  // the longest waiting first
+  priorityOverdue = maxOverdueFrames + 1;
+  reservedUpdates = 0;
+
+  for (int overdue = maxOverdueFrames; overdue > 0; overdue--)
+  {
+    int count = postponedOverdue[overdue - 1];
+
+    if (overdue == maxOverdueFrames)
+      count += postponedOverdue[overdue];
+
+    if (count == 0)
+      continue;
+
+    // Those that don't fit still wait longer next time, so they come first then
+    if (reservedUpdates + count > maxReducedUpdatesPerFrame)
+    {
+      // Even the longest waiting ones don't all fit: take them in order
+      if (reservedUpdates == 0)
+      {
+        priorityOverdue = overdue;
+        reservedUpdates = maxReducedUpdatesPerFrame;
+      }
+
+      break;
+    }
+
+    priorityOverdue = overdue;
+    reservedUpdates += count;
+  }
+
+  fill(postponedOverdue.begin(), postponedOverdue.end(), 0);
+
+  viewMin = viewTopLeft;
+  viewMax = viewTopLeft + viewSize;
+}
+
+int UpdateScheduler::GetInterval(Vector2 position) const
+{
+  // Distance to the view along each axis (0 when inside it)
+  float horizontal = max({viewMin.x - position.x, 0.0f, position.x - viewMax.x});
+  float vertical = max({viewMin.y - position.y, 0.0f, position.y - viewMax.y});
+
+  float squareDistance = horizontal * horizontal + vertical * vertical;
+
+  int interval = 1;
+
+  for (float distance : rateDistances)
+    if (squareDistance > distance * distance)
+      interval *= 2;
+
+  return interval;
+}
+
+bool UpdateScheduler::ShouldUpdate(int interval, int waitedFrames)
+{
+  if (interval == 1)
+  {
+    frameStats.full++;
+    return true;
+  }
+
+  if (waitedFrames < interval)
+  {
+    frameStats.skipped++;
+    return false;
+  }
+
+  int overdue = min(waitedFrames - interval, maxOverdueFrames);
+  bool priority = overdue >= priorityOverdue;
+
+  // Use up a kept slot
+  if (priority && reservedUpdates > 0)
+    reservedUpdates--;
+
+  // Others can't take the slots kept for components still to come
+  if (frameStats.reduced >= maxReducedUpdatesPerFrame - (priority ? 0 : reservedUpdates))
+  {
+    postponedOverdue[overdue]++;
+    frameStats.postponed++;
+    return false;
+  }
+
+  frameStats.reduced++;
+  return true;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include "WorkerPool.h"
+
+using namespace std;
+
+const int WorkerPool::maxWorkers{8};
+
+WorkerPool::WorkerPool()
+{
+  int workerCount = clamp((int)thread::hardware_concurrency(), 1, maxWorkers);
+
+  for (int worker = 1; worker < workerCount; worker++)
+    threads.emplace_back(&WorkerPool::Work, this, worker);
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+
+  jobStarted.notify_all();
+
+  for (auto &thread : threads)
+    thread.join();
+}
+
+void WorkerPool::Run(const Delegate<void(int)> &job)
+{
+  if (threads.empty())
+  {
+    job(0);
+    return;
+  }
+
+  {
+    lock_guard<std::mutex> lock(mutex);
+    this->job = &job;
+    busyThreads = threads.size();
+    jobNumber++;
+  }
+
+  jobStarted.notify_all();
+
+  // Do a share here too
+  job(0);
+
+  unique_lock<std::mutex> lock(mutex);
+  jobFinished.wait(lock, [this]()
+                   { return busyThreads == 0; });
+
+  this->job = nullptr;
+}
+
+void WorkerPool::Work(int worker)
+{
+  int lastJobNumber = 0;
+  unique_lock<std::mutex> lock(mutex);
+
+  while (true)
+  {
+    jobStarted.wait(lock, [this, lastJobNumber]()
+                    { return stopping || jobNumber != lastJobNumber; });
+
+    if (stopping)
+      return;
+
+    lastJobNumber = jobNumber;
+    auto currentJob = job;
+
+    lock.unlock();
+    (*currentJob)(worker);
+    lock.lock();
+
+    if (--busyThreads == 0)
+      jobFinished.notify_one();
+  }
+}
@@ -1,14 +1,89 @@
 #include <iostream>
+#include <string>
 #include "Game.h"
+#include "InputManager.h"
+#include "AllocationTracker.h"
+#include "GameData.h"
+#include "CollisionStats.h"
+#include "SpriteBatch.h"
+#include "BroadPhase.h"
+#include "SatCollision.h"
 // #include "test.h"
 
 using namespace std;
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+int main(int argc, char **argv)
 {
+  // Input script of a headless run
+  string scriptPath;
+
+  // Parse arguments
+  for (int i = 1; i < argc; i++)
+  {
+    // Fail the run whenever a steady state frame exceeds the allocation budget
+    if (string(argv[i]) == "--strict-allocations")
+      AllocationTracker::SetStrict(true);
+
+    // Print how many pairs collision detection goes through
+    else if (string(argv[i]) == "--collision-stats")
+      CollisionStats::SetReporting(true);
+
+    // Print how many draw calls the sprites are batched into
+    else if (string(argv[i]) == "--render-stats")
+      SpriteBatch::SetReporting(true);
+
+    // Compare the broad phases on a synthetic world, then quit
+    else if (string(argv[i]) == "--benchmark-broad-phase")
+    {
+      for (int proxyCount : {250, 1000, 4000})
+        BroadPhase::Benchmark(proxyCount, 60);
+
+      return 0;
+    }
+
+    // Check that the vector SAT kernel agrees with the scalar one on a fixed seed, failing the run if not, then quit
+    else if (string(argv[i]) == "--check-sat")
+    {
+      try
+      {
+        SatCollision::Check(500, 8, 1);
+      }
+      catch (const runtime_error &error)
+      {
+        cerr << "=> ERROR: " << error.what() << endl;
+
+        return 1;
+      }
+
+      return 0;
+    }
+
+    // Check the vector SAT kernel against the scalar one & time them, then quit
+    else if (string(argv[i]) == "--benchmark-sat")
+    {
+      SatCollision::Benchmark(1000, 20);
+
+      return 0;
+    }
+
+    // Play without a window, with the input read from a script
+    else if (string(argv[i]) == "--headless" && i + 1 < argc)
+    {
+      Game::SetHeadless(true);
+      scriptPath = argv[++i];
+    }
+
+    // Compare scene loading times instead of playing
+    else if (string(argv[i]) == "--benchmark-scene")
+      GameData::GetInstance().benchmarkScene = true;
+  }
+
   // Get game instance & run
   try
   {
+    if (scriptPath.empty() == false)
+      InputManager::GetInstance().PlayScript(scriptPath);
+
     Game &gameInstance = Game::GetInstance();
 
     gameInstance.Start();
@@ -17,7 +92,9 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
   catch (const runtime_error &error)
   {
     cerr << "=> ERROR: " << error.what() << endl;
+
+    return 1;
   }
 
   return 0;
-}
\ No newline at end of file
+}
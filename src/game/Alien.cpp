@@ -6,10 +6,18 @@
 #include "Minion.h"
 #include "Debug.h"
 #include "MainState.h"
+#include "ComponentRegistry.h"
 #include <iostream>
 
 using namespace std;
 
+static shared_ptr<Component> RebuildAlien(GameObject &object, [[maybe_unused]] BinaryReader &reader)
+{
+  return object.AddComponent<Alien>();
+}
+
+REGISTER_COMPONENT(Alien, RebuildAlien)
+
 // Rotation speed, in radians
 const float Alien::rotationSpeed{0.2f};
 
@@ -56,63 +64,54 @@ void Alien::Start()
             dynamic_pointer_cast<Alien>(GetShared()), 2 * M_PI * i / minionCount));
   }
 
-  // Start timer
-  gameObject.timer.Reset("idle", -RandomRange(idleTime.x, idleTime.y));
+  // Start acting
+  behavior = Act();
 }
 
 void Alien::Update([[maybe_unused]] float deltaTime)
 {
-  // If idle, check if timer is up
-  if (state == State::idle)
-  {
-    // If it's up, move
-    if (gameObject.timer.Get("idle") >= 0)
-      Chase();
-  }
-
-  // If it's chasing, do nothing
-
   // Rotate slowly
   gameObject.localRotation += rotationSpeed * deltaTime;
 }
 
-void Alien::Chase()
+void Alien::LoadState([[maybe_unused]] BinaryReader &reader) { minions.clear(); }
+
+void Alien::OnRestore()
 {
-  // Ignore if no penguin
-  if (penguinWeak.expired())
-    return;
+  movementWeak = gameObject.RequireComponent<Movement>();
+  penguinWeak = gameState.FindObjectOfType<PenguinBody>();
 
-  // Switch state
-  state = State::moving;
+  behavior = Act();
+}
 
-  // Get movement component
-  LOCK(movementWeak, movement);
+Behavior Alien::Act()
+{
+  while (true)
+  {
+    co_await Wait(RandomRange(idleTime.x, idleTime.y));
 
-  // Get penguin
-  LOCK(penguinWeak, penguin);
+    // Keep idling if no penguin
+    if (penguinWeak.expired())
+      continue;
 
-  // Move towards player
-  movement->MoveTo(
-      penguin->gameObject.GetPosition(), [this]()
-      { Arrive(); });
+    co_await Chase();
+
+    // Shoot at player
+    if (auto penguin = penguinWeak.lock())
+      Shoot(penguin->gameObject.GetPosition());
+  }
 }
 
-void Alien::Arrive()
+Movement::Arrival Alien::Chase()
 {
-  // Switch to idle state
-  state = State::idle;
+  // Get movement component
+  LOCK(movementWeak, movement);
 
   // Get penguin
-  if (penguinWeak.expired() == false)
-  {
-    LOCK(penguinWeak, penguin);
-
-    // Shoot at player
-    Shoot(penguin->gameObject.GetPosition());
-  }
+  LOCK(penguinWeak, penguin);
 
-  // Start timer
-  gameObject.timer.Reset("idle", -RandomRange(idleTime.x, idleTime.y));
+  // Move towards player
+  return movement->MoveTo(penguin->gameObject.GetPosition());
 }
 
 void Alien::Shoot(Vector2 position)
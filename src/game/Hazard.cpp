@@ -1,5 +1,18 @@
 #include "Hazard.h"
 #include "Health.h"
+#include "ComponentRegistry.h"
+
+using namespace std;
+
+static shared_ptr<Component> RebuildHazard(GameObject &object, BinaryReader &reader)
+{
+  Tag targetTag = reader.Read<Tag>();
+  float damage = reader.Read<float>();
+
+  return object.AddComponent<Hazard>(targetTag, damage, reader.Read<bool>());
+}
+
+REGISTER_COMPONENT(Hazard, RebuildHazard)
 
 Hazard::Hazard(
     GameObject &associatedObject,
@@ -8,7 +21,7 @@ Hazard::Hazard(
     bool destroyOnCollide)
     : Component(associatedObject), targetTag(targetTag), damage(damage), destroyOnCollide(destroyOnCollide) {}
 
-void Hazard::OnCollision(GameObject &other)
+void Hazard::OnCollisionEnter(GameObject &other)
 {
   // Ignore if other isn't of target tag
   if (other.tag != targetTag)
@@ -28,3 +41,10 @@ void Hazard::OnCollision(GameObject &other)
   if (destroyOnCollide)
     gameObject.RequestDestroy();
 }
+
+void Hazard::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(targetTag);
+  writer.Write(damage);
+  writer.Write(destroyOnCollide);
+}
@@ -1,7 +1,19 @@
 #include "Health.h"
+#include "ComponentRegistry.h"
+
+using namespace std;
+
+static shared_ptr<Component> RebuildHealth(GameObject &object, BinaryReader &reader)
+{
+  float healthPoints = reader.Read<float>();
+
+  return object.AddComponent<Health>(healthPoints, reader.Read<bool>());
+}
+
+REGISTER_COMPONENT(Health, RebuildHealth)
 
 Health::Health(GameObject &associatedObject, float totalHealth, bool destroyOnDeath)
-    : Component(associatedObject), healthPoints(totalHealth), destroyOnDeath(destroyOnDeath) {}
+    : Component(associatedObject), OnDeath(gameState.eventQueue), healthPoints(totalHealth), destroyOnDeath(destroyOnDeath) {}
 
 void Health::TakeDamage(float damage)
 {
@@ -16,4 +28,22 @@ void Health::TakeDamage(float damage)
     if (destroyOnDeath)
       gameObject.RequestDestroy();
   }
-}
\ No newline at end of file
+}
+
+void Health::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(healthPoints);
+  writer.Write(destroyOnDeath);
+}
+
+void Health::SaveState(BinaryWriter &writer)
+{
+  writer.Write(healthPoints);
+  writer.Write(deathTriggered);
+}
+
+void Health::LoadState(BinaryReader &reader)
+{
+  healthPoints = reader.Read<float>();
+  deathTriggered = reader.Read<bool>();
+}
@@ -4,13 +4,36 @@
 #include "Recipes.h"
 #include "Camera.h"
 #include "Tilemap.h"
+#include "BinaryStream.h"
+#include "SweepAndPrune.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
 
 using namespace std;
 
 const int MainState::totalAliens{5};
 const float MainState::dieAdvanceTime{2};
-const float MainState::edgeSlack{80};
+// The ice tiles are all open ground: only the cells around the map block movement
+const vector<bool> MainState::solidTiles{};
+const int MainState::tilesPerRegion{8};
+const float MainState::activationRadius{1000};
+const int MainState::rewindFrames{120};
+const string MainState::quickSavePath{"./quicksave.scene"};
+const int MainState::benchmarkIterations{50};
 
+MainState::MainState()
+{
+  // Most colliders only drift a few pixels each frame, which sweep and prune handles in about linear time
+  SetBroadPhase(make_unique<SweepAndPrune>());
+
+  // Only test pairs where one can hurt the other (hazards ignore every other tag anyway)
+  collisionMatrix.Clear();
+  collisionMatrix.SetInteraction(CollisionLayer::Player, CollisionLayer::Enemies, true);
+  collisionMatrix.SetInteraction(CollisionLayer::Player, CollisionLayer::EnemyProjectiles, true);
+  collisionMatrix.SetInteraction(CollisionLayer::Enemies, CollisionLayer::PlayerProjectiles, true);
+}
 
 void MainState::AdvanceState(bool victory)
 {
@@ -21,37 +44,123 @@ void MainState::AdvanceState(bool victory)
   popRequested = true;
 }
 
+void MainState::OnPlayerDeath()
+{
+  timer.After(dieAdvanceTime, [this]()
+              { AdvanceState(false); });
+}
+
+void MainState::OnAlienDeath()
+{
+  //  If all aliens are dead, win
+  if (--alienCount == 0)
+    AdvanceState(true);
+}
+
+void MainState::ListenToAlienDeath(Health &health)
+{
+  health.OnDeath.AddListener([this]()
+                             { OnAlienDeath(); });
+}
+
+void MainState::SaveState(BinaryWriter &writer) { writer.Write(alienCount); }
+
+void MainState::LoadState(BinaryReader &reader) { alienCount = reader.Read<int>(); }
+
+void MainState::OnRestore()
+{
+  // The penguin may have been rebuilt
+  auto penguinBody = FindObjectOfType<PenguinBody>();
+  auto penguin = penguinBody ? penguinBody->gameObject.GetShared() : nullptr;
+
+  if (penguin && penguin != penguinWeak.lock())
+  {
+    regionGrid.AddAnchor(penguin);
+    Camera::GetInstance().Follow(penguin);
+  }
+
+  penguinWeak = penguin;
+
+  // Listeners can't be saved, so objects rebuilt by the restore come back without them
+  for (auto &objectPair : gameObjects)
+  {
+    auto object = objectPair.second;
+
+    if (object->GetComponent<Alien>())
+      if (auto health = object->GetComponent<Health>(); health && health->OnDeath.Count() == 0)
+        ListenToAlienDeath(*health);
+  }
+}
+
+// Most random positions tried when looking for one distant from a target
+static const int spawnAttempts{64};
+
 Vector2 GetPositionDistantFrom(const TileMap &tilemap, Vector2 target, float minDistance)
 {
-  while (true)
+  Vector2 farthest;
+  float farthestSqrDistance = -1;
+
+  // A map with little room that far from the target could take forever, so settle for the farthest position tried
+  for (int attempt = 0; attempt < spawnAttempts; attempt++)
   {
     // Get a position
     Vector2 position = Vector2(
         RandomRange(-tilemap.GetWidth() / 2, tilemap.GetWidth() / 2),
         RandomRange(-tilemap.GetHeight() / 2, tilemap.GetHeight() / 2));
 
+    float sqrDistance = Vector2::SqrDistance(position, target);
+
     // Check if it's far enough
-    if (Vector2::SqrDistance(position, target) >= minDistance * minDistance)
+    if (sqrDistance >= minDistance * minDistance)
       return position;
+
+    if (sqrDistance > farthestSqrDistance)
+    {
+      farthest = position;
+      farthestSqrDistance = sqrDistance;
+    }
   }
+
+  return farthest;
 }
 
 void MainState::InitializeObjects()
+{
+  CreateScene();
+
+  auto penguin = penguinWeak.lock();
+
+  // Keep the penguin's surroundings awake
+  regionGrid.AddAnchor(penguin);
+
+  // Make camera follow penguin
+  Camera::GetInstance()
+      .Follow(penguin);
+
+  // Play music
+  music.Play("./assets/music/main.mp3");
+}
+
+void MainState::CreateScene()
 {
   // Add a background
   CreateObject("Background", Recipes::Background("./assets/image/ocean.jpg"));
 
   // Add a tilemap
   auto tilemap = CreateObject("Tilemap", Recipes::Tilemap)->GetComponent<TileMap>();
-  tilemapWeak = tilemap;
 
-  // Function to count alien death
-  auto CountAlienDeath = [this]()
+  // The map is always the same, so the grids only need to be set up once
+  if (regionGrid.IsConfigured() == false)
   {
-    //  If all aliens are dead, win
-    if (--alienCount == 0)
-      AdvanceState(true);
-  };
+    // Split the map in regions, so that what happens far away sleeps (the background and tilemap are left out, as they were created before)
+    Vector2 tileSize(tilemap->GetWidth() / tilemap->HorizontalTileCount(), tilemap->GetHeight() / tilemap->VerticalTileCount());
+    Vector2 mapCorner = tilemap->gameObject.GetPosition() - Vector2(tilemap->GetWidth(), tilemap->GetHeight()) / 2;
+
+    regionGrid.Configure(mapCorner, tileSize, tilesPerRegion, activationRadius);
+
+    // Let bodies collide with the ground layer's solid tiles, and wall the map in
+    tileGrid.Build(*tilemap, 0, solidTiles, true);
+  }
 
   // Add penguins
   auto penguin = CreateObject("Penguin Body", Recipes::PenguinBody);
@@ -69,42 +178,127 @@ void MainState::InitializeObjects()
     auto alien = CreateObject("Alien", Recipes::Alien, alienPosition);
 
     // When it dies, decrement counter
-    alien->GetComponent<Health>()->OnDeath.AddListener("stateCounterDecrement", CountAlienDeath);
+    ListenToAlienDeath(*alien->GetComponent<Health>());
   }
+}
 
-  // Make camera follow penguin
-  Camera::GetInstance()
-      .Follow(penguin);
+void MainState::BenchmarkScene()
+{
+  using Clock = chrono::steady_clock;
 
-  // Play music
-  music.Play("./assets/music/main.mp3");
+  // Removes every object silently, as restoring a snapshot does
+  auto ClearObjects = [this]()
+  {
+    rootObject->children.clear();
+    gameObjects.clear();
+    timingWheel.Clear();
+  };
+
+  auto Milliseconds = [](Clock::duration duration)
+  { return chrono::duration<double, milli>(duration).count() / benchmarkIterations; };
+
+  // Build it's objects from recipes (the state itself was set up once, by InitializeObjects)
+  Clock::duration recipeTime{};
+
+  for (int i = 0; i < benchmarkIterations; i++)
+  {
+    ClearObjects();
+
+    auto start = Clock::now();
+    CreateScene();
+    recipeTime += Clock::now() - start;
+  }
+
+  // Save the scene as it is to a file
+  Clock::duration saveTime{};
+  Snapshot scene;
+
+  for (int i = 0; i < benchmarkIterations; i++)
+  {
+    auto start = Clock::now();
+    scene.Capture(*this, false);
+    scene.WriteFile(quickSavePath);
+    saveTime += Clock::now() - start;
+  }
+
+  // Read it from the file
+  Clock::duration fileTime{};
+
+  for (int i = 0; i < benchmarkIterations; i++)
+  {
+    ClearObjects();
+
+    auto start = Clock::now();
+    Snapshot loaded;
+    loaded.ReadFile(quickSavePath);
+    loaded.Restore(*this);
+    fileTime += Clock::now() - start;
+  }
+
+  remove(quickSavePath.c_str());
+
+  cout << "Scene of " << gameObjects.size() << " objects (" << scene.GetSize() << " bytes)" << endl
+       << "From recipes: " << Milliseconds(recipeTime) << "ms" << endl
+       << "To file: " << Milliseconds(saveTime) << "ms" << endl
+       << "From file: " << Milliseconds(fileTime) << "ms" << endl;
 }
 
 void MainState::Update(float deltaTime)
 {
-  // Kill player it he exceeds the map's boundaries
+  if (initialScene.IsEmpty())
+  {
+    if (GameData::GetInstance().benchmarkScene)
+    {
+      BenchmarkScene();
+      quitRequested = true;
+      return;
+    }
+
+    initialScene.Capture(*this, false);
+  }
+
+  // Restart
+  if (inputManager.KeyPress(R_KEY))
+  {
+    initialScene.Restore(*this);
+    return;
+  }
+
+  // Quick save & quick load
+  if (inputManager.KeyPress(F5_KEY))
   {
-    LOCK(tilemapWeak, tilemap);
-    // If die timer is up, advance
-    if (timer.Get("advanceState") > dieAdvanceTime)
-      AdvanceState(false);
+    Snapshot scene;
+    scene.Capture(*this, false);
+    scene.WriteFile(quickSavePath);
+  }
 
-    if (penguinWeak.expired() == false)
+  else if (inputManager.KeyPress(F9_KEY))
+  {
+    if (ifstream(quickSavePath).is_open() == false)
     {
-      LOCK(penguinWeak, penguin);
-      if (
-          abs(penguin->GetPosition().x) > tilemap->GetWidth() / 2 + edgeSlack ||
-          abs(penguin->GetPosition().y) > tilemap->GetHeight() / 2 + edgeSlack)
-      {
-        // Starts advance timer
-        penguin->RequestDestroy();
-      }
+      WARN("There is no quick save to load");
+      return;
     }
+
+    Snapshot scene;
+    scene.ReadFile(quickSavePath);
+    scene.Restore(*this);
+    return;
+  }
+
+  // Go back in time while backspace is held
+  if (inputManager.IsKeyDown(BACKSPACE_KEY))
+  {
+    rollback.Rewind(*this);
+    return;
   }
 
   // Call base
   GameState::Update(deltaTime);
 
+  // Keep this frame, so it can be rewound to
+  rollback.Record(*this);
+
   // Pop this state on esc key
   if (inputManager.KeyRelease(ESCAPE_KEY))
   {
@@ -5,10 +5,20 @@
 #include "Sprite.h"
 #include "SpriteAnimator.h"
 #include "MainState.h"
+#include "Alien.h"
+#include "ComponentRegistry.h"
 #include <math.h>
 
 using namespace std;
 
+static shared_ptr<Component> RebuildMinion(GameObject &object, BinaryReader &reader)
+{
+  // The host is found again on restore
+  return object.AddComponent<Minion>(weak_ptr<GameObject>(), reader.Read<float>());
+}
+
+REGISTER_COMPONENT(Minion, RebuildMinion)
+
 // Speed at which to orbit the host alien, in radians
 const float Minion::angularSpeed{0.5f};
 
@@ -36,7 +46,7 @@ Minion::Minion(GameObject &associatedObject, weak_ptr<GameObject> hostPointer, f
     : Component(associatedObject), hostPointer(hostPointer), arc(startingArc)
 {
   // Initialize radius
-  orbitRadius = (rand() % (int)floor(radiusLimits[1] - radiusLimits[0])) + radiusLimits[0];
+  orbitRadius = RandomRange(radiusLimits[0], radiusLimits[1]);
 
   // Set scale
   auto scale = RandomRange(scaleLimits[0], scaleLimits[1]);
@@ -102,4 +112,37 @@ void Minion::Shoot(Vector2 target)
               "./assets/image/minionbullet2.png", Vector2(33, 12), 0.2f, true,
               Tag::Player, targetAngle, projectileSpeed, projectileTimeToLive, projectileDamage),
           gameObject.GetPosition());
-}
\ No newline at end of file
+}
+
+void Minion::SaveConstruction(BinaryWriter &writer) { writer.Write(arc); }
+
+void Minion::SaveState(BinaryWriter &writer)
+{
+  auto host = hostPointer.lock();
+
+  writer.Write(host ? host->id : -1);
+  writer.Write(arc);
+  writer.Write(orbitRadius);
+  writer.Write(floatDirection);
+}
+
+void Minion::LoadState(BinaryReader &reader)
+{
+  hostId = reader.Read<int>();
+  arc = reader.Read<float>();
+  orbitRadius = reader.Read<float>();
+  floatDirection = reader.Read<float>();
+}
+
+void Minion::OnRestore()
+{
+  auto host = hostId >= 0 ? gameState.GetObject(hostId) : nullptr;
+  hostPointer = host;
+
+  if (!host)
+    return;
+
+  // The alien forgot it's minions when loaded, so that they are listed in the same order they were created
+  if (auto alien = host->GetComponent<Alien>())
+    alien->minions.emplace_back(gameObject.GetShared());
+}
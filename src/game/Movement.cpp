@@ -1,7 +1,19 @@
 #include "Movement.h"
+#include "ComponentRegistry.h"
+#include "GameState.h"
 
 using namespace std;
 
+static shared_ptr<Component> RebuildMovement(GameObject &object, BinaryReader &reader)
+{
+  float acceleration = reader.Read<float>();
+  float targetSpeed = reader.Read<float>();
+
+  return object.AddComponent<Movement>(acceleration, targetSpeed, reader.Read<bool>());
+}
+
+REGISTER_COMPONENT(Movement, RebuildMovement)
+
 void Movement::Update(float deltaTime)
 {
   // Follow a target if it exists
@@ -15,7 +27,24 @@ void Movement::Update(float deltaTime)
   if (!velocity)
     return;
 
-  gameObject.localPosition += velocity * deltaTime;
+  Vector2 motion = velocity * deltaTime;
+
+  // Stop at solid tiles, losing the speed along the blocked axis
+  if (blockedByTiles)
+    if (auto collider = gameObject.GetComponent<Collider>())
+    {
+      Vector2 allowed = gameState.tileGrid.Resolve(Bounds::Of(collider->GetBox(), gameObject.GetRotation()), motion);
+
+      if (allowed.x != motion.x)
+        velocity.x = 0;
+
+      if (allowed.y != motion.y)
+        velocity.y = 0;
+
+      motion = allowed;
+    }
+
+  gameObject.localPosition += motion;
 }
 
 void Movement::Accelerate(float deltaTime)
@@ -32,14 +61,35 @@ void Movement::Accelerate(float deltaTime)
 void Movement::Move(Vector2 direction, bool cancelFollow)
 {
   targetDirection = direction;
-  followTarget = followTarget && !cancelFollow;
+
+  if (followTarget && cancelFollow)
+  {
+    followTarget = false;
+
+    // The target is gone, so it won't be reached
+    ResumeArrival();
+  }
 }
 
-void Movement::MoveTo(Vector2 position, std::function<void()> callback)
+auto Movement::MoveTo(Vector2 position, Delegate<void()> callback) -> Arrival
 {
   targetPosition = position;
   followTarget = true;
-  targetReachCallback = callback;
+  targetReachCallback = move(callback);
+
+  int thisMove = ++moveCount;
+
+  // Whoever waited on the previous target won't reach it
+  ResumeArrival();
+
+  return Arrival(dynamic_pointer_cast<Movement>(GetShared()), thisMove);
+}
+
+void Movement::ResumeArrival()
+{
+  // Take it out first, as the behavior may set a new target
+  if (auto coroutine = exchange(waitingArrival, nullptr))
+    coroutine.resume();
 }
 
 void Movement::FollowTarget(float deltaTime)
@@ -57,8 +107,13 @@ void Movement::FollowTarget(float deltaTime)
     velocity = Vector2::Zero();
     targetDirection = Vector2::Zero();
 
-    if (targetReachCallback != nullptr)
-      targetReachCallback();
+    // Take the callback out, as it may set a new target
+    auto callback = move(targetReachCallback);
+
+    if (callback != nullptr)
+      callback();
+
+    ResumeArrival();
 
     return;
   }
@@ -66,3 +121,57 @@ void Movement::FollowTarget(float deltaTime)
   // Get target angle
   Move((targetPosition - gameObject.GetPosition()).Normalized(), false);
 }
+
+void Movement::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(acceleration);
+  writer.Write(targetSpeed);
+  writer.Write(blockedByTiles);
+}
+
+void Movement::SaveState(BinaryWriter &writer)
+{
+  writer.Write(velocity);
+  writer.Write(targetDirection);
+  writer.Write(targetPosition);
+  writer.Write(followTarget);
+}
+
+void Movement::LoadState(BinaryReader &reader)
+{
+  velocity = reader.ReadVector2();
+  targetDirection = reader.ReadVector2();
+  targetPosition = reader.ReadVector2();
+  followTarget = reader.Read<bool>();
+
+  // Whoever waited on it must ask again (moveCount is kept going, so that old arrivals stay stale)
+  targetReachCallback = nullptr;
+  waitingArrival = nullptr;
+}
+
+// === ARRIVAL =================================
+
+bool Movement::Arrival::await_ready() const
+{
+  auto movement = movementWeak.lock();
+
+  return !movement || movement->moveCount != move || movement->followTarget == false;
+}
+
+void Movement::Arrival::await_suspend(coroutine_handle<> coroutine)
+{
+  LOCK(movementWeak, movement);
+
+  movement->waitingArrival = coroutine;
+
+  waiting = true;
+}
+
+Movement::Arrival::~Arrival()
+{
+  if (waiting == false)
+    return;
+
+  if (auto movement = movementWeak.lock(); movement && movement->moveCount == move)
+    movement->waitingArrival = nullptr;
+}
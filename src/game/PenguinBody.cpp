@@ -3,9 +3,20 @@
 #include "InputManager.h"
 #include "Health.h"
 #include "MainState.h"
+#include "ComponentRegistry.h"
 
 using namespace std;
 
+static shared_ptr<Component> RebuildPenguinBody(GameObject &object, BinaryReader &reader)
+{
+  int movementIndex = reader.Read<int>();
+  auto movement = movementIndex >= 0 ? dynamic_pointer_cast<Movement>(object.GetComponentAt(movementIndex)) : nullptr;
+
+  return object.AddComponent<PenguinBody>(movement);
+}
+
+REGISTER_COMPONENT(PenguinBody, RebuildPenguinBody)
+
 // INITIALIZATION
 const float PenguinBody::proportionAcceleration{30.0f};
 const float PenguinBody::acceleration{1.0f};
@@ -21,8 +32,9 @@ void PenguinBody::OnBeforeDestroy()
 
   gameObject.gameState.CreateObject("Penguin Explosion", ExplosionRecipe, gameObject.GetPosition());
 
-  // Start advance state timer
-  gameObject.gameState.timer.Start("advanceState");
+  // Let the state know
+  if (auto mainState = dynamic_cast<MainState *>(&gameObject.gameState))
+    mainState->OnPlayerDeath();
 }
 
 void PenguinBody::Update(float deltaTime)
@@ -36,7 +48,7 @@ void PenguinBody::Update(float deltaTime)
 
 void PenguinBody::Accelerate(float deltaTime)
 {
-  InputManager inputManager = InputManager::GetInstance();
+  InputManager &inputManager = InputManager::GetInstance();
 
   auto SetSpeedProportion = [this](float speed)
   {
@@ -57,7 +69,7 @@ void PenguinBody::Accelerate(float deltaTime)
 
 void PenguinBody::Rotate(float deltaTime)
 {
-  InputManager inputManager = InputManager::GetInstance();
+  InputManager &inputManager = InputManager::GetInstance();
 
   // Rotate left with A
   if (inputManager.IsKeyDown(SDLK_a))
@@ -77,3 +89,14 @@ void PenguinBody::Rotate(float deltaTime)
     movement->Move(Vector2::Angled(gameObject.GetRotation(), speedProportion));
   }
 }
+
+void PenguinBody::SaveConstruction(BinaryWriter &writer)
+{
+  auto movement = movementWeak.lock();
+
+  writer.Write(movement ? gameObject.GetComponentIndex(movement.get()) : -1);
+}
+
+void PenguinBody::SaveState(BinaryWriter &writer) { writer.Write(speedProportion); }
+
+void PenguinBody::LoadState(BinaryReader &reader) { speedProportion = reader.Read<float>(); }
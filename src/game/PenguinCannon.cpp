@@ -4,9 +4,18 @@
 #include "SpriteAnimator.h"
 #include "Projectile.h"
 #include "MainState.h"
+#include "ComponentRegistry.h"
+#include <cmath>
 
 using namespace std;
 
+static shared_ptr<Component> RebuildPenguinCannon(GameObject &object, [[maybe_unused]] BinaryReader &reader)
+{
+  return object.AddComponent<PenguinCannon>();
+}
+
+REGISTER_COMPONENT(PenguinCannon, RebuildPenguinCannon)
+
 // Projectile speed
 const float PenguinCannon::projectileSpeed{300};
 
@@ -19,10 +28,19 @@ const float PenguinCannon::projectileDamage{50};
 // Cooldown
 const float PenguinCannon::cooldown{0.3f};
 
+// How far around the mouse to look for an enemy to aim at
+const float PenguinCannon::aimAssistRadius{100};
+
+// Most radians a shot is turned by to aim at an enemy
+const float PenguinCannon::aimAssistAngle{0.15f};
+
+// Identifier of the cooldown timer
+const TimerId PenguinCannon::cooldownTimer{Timer::Intern("cooldown")};
+
 void PenguinCannon::Start()
 {
   // Start a cooldown timer
-  gameObject.timer.Reset("cooldown", cooldown);
+  gameObject.timer.Reset(cooldownTimer, cooldown);
 }
 
 void PenguinCannon::Update([[maybe_unused]] float deltaTime)
@@ -41,11 +59,13 @@ void PenguinCannon::Update([[maybe_unused]] float deltaTime)
 void PenguinCannon::Shoot()
 {
   // Check if cooldown is done
-  if (gameObject.timer.Get("cooldown") < cooldown)
+  if (gameObject.timer.Get(cooldownTimer) < cooldown)
     return;
 
   // Restart cooldown
-  gameObject.timer.Reset("cooldown");
+  gameObject.timer.Reset(cooldownTimer);
+
+  gameObject.SetRotation(AssistedRotation());
 
   // Create the projectile
   gameState
@@ -57,6 +77,31 @@ void PenguinCannon::Shoot()
           GunPointPosition());
 }
 
+float PenguinCannon::AssistedRotation()
+{
+  float rotation = gameObject.GetRotation();
+  Vector2 position = gameObject.GetPosition();
+
+  // Check whether the shot is already on target, against what the projectile would hit
+  RaycastHit hit;
+  uint32_t targetLayers = gameState.collisionMatrix.GetMask(CollisionLayer::PlayerProjectiles);
+
+  if (gameState.Raycast(position, Vector2::Angled(rotation), projectileSpeed * projectileTimeToLive, hit, targetLayers))
+    return rotation;
+
+  // Otherwise look for the enemy the player was likely aiming at
+  nearbyEnemies.clear();
+  gameState.FindNearest(InputManager::GetInstance().GetMouseWorldCoordinates(), Tag::Enemy, 1, nearbyEnemies, aimAssistRadius);
+
+  if (nearbyEnemies.empty())
+    return rotation;
+
+  float enemyRotation = Vector2::AngleBetween(position, nearbyEnemies[0]->GetPosition());
+  nearbyEnemies.clear();
+
+  return abs(remainder(enemyRotation - rotation, 2 * M_PI)) <= aimAssistAngle ? enemyRotation : rotation;
+}
+
 Vector2 PenguinCannon::GunPointPosition()
 {
   // Get image size
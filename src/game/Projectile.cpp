@@ -1,9 +1,22 @@
 #include "Projectile.h"
+#include "ComponentRegistry.h"
 #include <cmath>
 #include <string>
 
 using namespace std;
 
+static shared_ptr<Component> RebuildProjectile(GameObject &object, BinaryReader &reader)
+{
+  float angle = reader.Read<float>();
+  float speed = reader.Read<float>();
+  float timeToLive = reader.Read<float>();
+
+  // The target is found again on restore
+  return object.AddComponent<Projectile>(angle, speed, timeToLive, weak_ptr<GameObject>(), reader.Read<float>());
+}
+
+REGISTER_COMPONENT(Projectile, RebuildProjectile)
+
 Projectile::Projectile(
     GameObject &associatedObject,
     float startingAngle,
@@ -54,3 +67,32 @@ void Projectile::Chase()
   // Adjust rotation
   gameObject.SetRotation(speed.Angle());
 }
+
+void Projectile::SaveConstruction(BinaryWriter &writer)
+{
+  writer.Write(angle);
+  writer.Write(speed.Magnitude());
+  writer.Write(timeToLive);
+  writer.Write(chaseSteering);
+}
+
+void Projectile::SaveState(BinaryWriter &writer)
+{
+  auto target = targetWeak.lock();
+
+  writer.Write(speed);
+  writer.Write(timeToLive);
+  writer.Write(target ? target->id : -1);
+}
+
+void Projectile::LoadState(BinaryReader &reader)
+{
+  speed = reader.ReadVector2();
+  timeToLive = reader.Read<float>();
+  targetId = reader.Read<int>();
+}
+
+void Projectile::OnRestore()
+{
+  targetWeak = targetId >= 0 ? gameState.GetObject(targetId) : nullptr;
+}
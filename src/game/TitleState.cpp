@@ -14,8 +14,10 @@ void TitleState::InitializeObjects()
 
   // Add a text instruction
   auto instruction = CreateObject("Instruction", Recipes::Text("Press Space to start", 50, Color(192, 180, 16)), Vector2(0, 200));
-  instruction->timer.Reset("flash", -instructionFlashTime);
-  instructionWeak = instruction;
+
+  // Make it flash
+  instruction->timer.Every(instructionFlashTime, [instruction = instruction.get()]()
+                           { instruction->SetEnabled(!instruction->IsEnabled()); });
 }
 
 void TitleState::Update(float deltaTime)
@@ -23,14 +25,6 @@ void TitleState::Update(float deltaTime)
   // Call base
   GameState::Update(deltaTime);
 
-  // Check if needs to change instruction visibility
-  LOCK(instructionWeak, instruction);
-  if (instruction->timer.Get("flash") >= 0)
-  {
-    instruction->SetEnabled(!instruction->IsEnabled());
-    instruction->timer.Reset("flash", -instructionFlashTime);
-  }
-
   // Quit on esc key
   if (inputManager.KeyRelease(ESCAPE_KEY))
   {